@@ -78,6 +78,10 @@ done
 if [ -z "$CC" ]; then
     CC=cc
 fi
+# The tools run during the build use the host's compiler
+if [ -z "$HOST_CC" ]; then
+    HOST_CC=$CC
+fi
 
 # Directories
 ROOT_DIR=$PWD
@@ -160,6 +164,10 @@ cp $ROOT_DIR/resources/macos/icon.icns Metro.icns
 mkdir -p metro_assets
 cd metro_assets
 cp $ROOT_DIR/resources/icon.png .
+# The narration script is compiled from src/script.h by a tool that runs
+# on the build machine, so it's built with the host's compiler
+$HOST_CC -std=c99 -o $ROOT_DIR/$TEMP_DIR/compile_script $ROOT_DIR/tools/compile_script.c $ROOT_DIR/src/narration.c
+$ROOT_DIR/$TEMP_DIR/compile_script script.bin
 cp -r $ROOT_DIR/src/shaders .
 mkdir -p fonts
 cp $ROOT_DIR/vendor/vt323/vt323.ttf fonts/
@@ -0,0 +1,376 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(_WIN32)
+// For mkdir
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <direct.h>
+#endif
+
+#include "font_cache.h"
+#include "little_endian.h"
+
+// The cache file starts with these, followed by the key it was made
+// with, the atlas size and format, the chars and finally the atlas
+// pixels. All values are little-endian, like in input logs.
+#define FONT_CACHE_MAGIC "MTFA"
+#define FONT_CACHE_VERSION 2
+#define FONT_CACHE_KEY_VALUES 8
+#define FONT_CACHE_HEADER_SIZE (5 + (FONT_CACHE_KEY_VALUES + 3) * 4)
+#define FONT_CACHE_CHAR_SIZE (8 * 4)
+
+// The padding GenImageFontAtlas is called with by LoadFontEx, SDF glyphs
+// already contain their own padding
+#define ATLAS_PADDING 2
+
+// The font file is identified by its size and modification time, which
+// are cheap to check, and the hash of its contents, which is only
+// computed when those don't match (e.g. after reinstalling the game)
+typedef struct {
+    unsigned int fileSize;
+    unsigned int fileTimeLow;
+    unsigned int fileTimeHigh;
+    unsigned int fileHash;
+    unsigned int fontSize;
+    unsigned int type;
+    unsigned int charsCount;
+    unsigned int charsHash;
+} FontCacheKey;
+
+#define FNV_OFFSET_BASIS 2166136261u
+
+// 32-bit FNV-1a, continuing from the given hash
+static
+unsigned int HashBytes(unsigned int hash, const unsigned char *bytes,
+                       size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static
+unsigned char *ReadWholeFile(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+    unsigned char *data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc(size);
+        if (data != NULL && fread(data, 1, size, file) != (size_t)size) {
+            free(data);
+            data = NULL;
+        }
+        *length = (size_t)size;
+    }
+    fclose(file);
+    return data;
+}
+
+static
+bool HashFile(const char *path, unsigned int *hash) {
+    size_t length = 0;
+    unsigned char *data = ReadWholeFile(path, &length);
+    if (data == NULL) {
+        return false;
+    }
+    *hash = HashBytes(FNV_OFFSET_BASIS, data, length);
+    free(data);
+    return true;
+}
+
+static
+void MakeDirectory(const char *path) {
+#if defined(_WIN32)
+    _mkdir(path);
+#else
+    mkdir(path, 0700);
+#endif
+}
+
+// Writes the path of the cache file for the font into path, under the
+// user's cache directory: %LOCALAPPDATA%\metro on Windows,
+// ~/Library/Caches/metro on macOS, and $XDG_CACHE_HOME/metro (or
+// ~/.cache/metro) elsewhere. The directories are created if they don't
+// exist. Returns false if there's no cache directory.
+static
+bool GetCachePath(char *path, size_t size, const char *fileName,
+                  int fontSize, int type) {
+    char directory[512];
+    int length;
+#if defined(_WIN32)
+    const char *localAppData = getenv("LOCALAPPDATA");
+    if (localAppData == NULL || localAppData[0] == '\0') {
+        return false;
+    }
+    length = snprintf(directory, sizeof(directory), "%s\\metro",
+                      localAppData);
+#else
+    char parent[512];
+    const char *home = getenv("HOME");
+#if defined(__APPLE__)
+    const char *xdgCache = NULL;
+#else
+    const char *xdgCache = getenv("XDG_CACHE_HOME");
+#endif
+    if (xdgCache != NULL && xdgCache[0] != '\0') {
+        length = snprintf(parent, sizeof(parent), "%s", xdgCache);
+    } else if (home != NULL && home[0] != '\0') {
+#if defined(__APPLE__)
+        length = snprintf(parent, sizeof(parent), "%s/Library/Caches", home);
+#else
+        length = snprintf(parent, sizeof(parent), "%s/.cache", home);
+#endif
+    } else {
+        return false;
+    }
+    if (length <= 0 || (size_t)length >= sizeof(parent)) {
+        return false;
+    }
+    MakeDirectory(parent);
+    length = snprintf(directory, sizeof(directory), "%s/metro", parent);
+#endif
+    if (length <= 0 || (size_t)length >= sizeof(directory)) {
+        return false;
+    }
+    MakeDirectory(directory);
+
+    // The fonts are told apart by their file names, the key takes care of
+    // different fonts (or versions) with the same name
+    const char *baseName = fileName;
+    for (const char *c = fileName; *c != '\0'; c++) {
+        if (*c == '/' || *c == '\\') {
+            baseName = c + 1;
+        }
+    }
+    length = snprintf(path, size, "%s/%s-%i%s.atlas", directory, baseName,
+                      fontSize, type == FONT_SDF ? "sdf" : "");
+    return length > 0 && (size_t)length < size;
+}
+
+static
+void KeyToValues(const FontCacheKey *key,
+                 unsigned int values[FONT_CACHE_KEY_VALUES]) {
+    values[0] = key->fileSize;
+    values[1] = key->fileTimeLow;
+    values[2] = key->fileTimeHigh;
+    values[3] = key->fileHash;
+    values[4] = key->fontSize;
+    values[5] = key->type;
+    values[6] = key->charsCount;
+    values[7] = key->charsHash;
+}
+
+// Reads the whole cache file at once, and loads the font from it if it
+// matches the key. The font file is only hashed (into key->fileHash) if
+// its modification time doesn't match. Returns false if the cache can't
+// be used.
+static
+bool LoadFontAtlasCache(const char *path, const char *fileName,
+                        FontCacheKey *key, Font *font) {
+    size_t length = 0;
+    unsigned char *data = ReadWholeFile(path, &length);
+    if (data == NULL) {
+        return false;
+    }
+
+    bool valid = length >= FONT_CACHE_HEADER_SIZE &&
+        memcmp(data, FONT_CACHE_MAGIC, 4) == 0 &&
+        data[4] == FONT_CACHE_VERSION;
+    const unsigned char *cursor = data + 5;
+    unsigned int cachedValues[FONT_CACHE_KEY_VALUES] = { 0 };
+    for (int i = 0; valid && i < FONT_CACHE_KEY_VALUES; i++) {
+        cursor = GetU32(cursor, &cachedValues[i]);
+    }
+    unsigned int keyValues[FONT_CACHE_KEY_VALUES];
+    KeyToValues(key, keyValues);
+    // Everything but the font file's time and hash has to match as is
+    for (int i = 0; valid && i < FONT_CACHE_KEY_VALUES; i++) {
+        if (i < 1 || i > 3) {
+            valid = cachedValues[i] == keyValues[i];
+        }
+    }
+    if (valid && cachedValues[1] == keyValues[1] &&
+        cachedValues[2] == keyValues[2]) {
+        // The font hasn't been modified since the cache was made
+        key->fileHash = cachedValues[3];
+    } else if (valid) {
+        // The font was modified (or at least touched), so only its
+        // contents tell if the cache is still good
+        valid = HashFile(fileName, &key->fileHash) &&
+            key->fileHash == cachedValues[3];
+    }
+
+    unsigned int width = 0, height = 0, format = 0;
+    size_t pixelsSize = 0;
+    if (valid) {
+        cursor = GetU32(cursor, &width);
+        cursor = GetU32(cursor, &height);
+        cursor = GetU32(cursor, &format);
+        valid = width > 0 && width <= 16384 && height > 0 &&
+            height <= 16384 && format == UNCOMPRESSED_GRAY_ALPHA;
+    }
+    if (valid) {
+        pixelsSize = GetPixelDataSize(width, height, format);
+        valid = length == FONT_CACHE_HEADER_SIZE +
+            key->charsCount * FONT_CACHE_CHAR_SIZE + pixelsSize;
+    }
+    CharInfo *chars = NULL;
+    if (valid) {
+        chars = calloc(key->charsCount, sizeof(CharInfo));
+        valid = chars != NULL;
+    }
+    if (!valid) {
+        free(data);
+        return false;
+    }
+
+    for (unsigned int i = 0; i < key->charsCount; i++) {
+        unsigned int value, offsetX, offsetY, advanceX;
+        cursor = GetU32(cursor, &value);
+        cursor = GetU32(cursor, &offsetX);
+        cursor = GetU32(cursor, &offsetY);
+        cursor = GetU32(cursor, &advanceX);
+        cursor = GetF32(cursor, &chars[i].rec.x);
+        cursor = GetF32(cursor, &chars[i].rec.y);
+        cursor = GetF32(cursor, &chars[i].rec.width);
+        cursor = GetF32(cursor, &chars[i].rec.height);
+        chars[i].value = (int)value;
+        chars[i].offsetX = (int)offsetX;
+        chars[i].offsetY = (int)offsetY;
+        chars[i].advanceX = (int)advanceX;
+        // The glyph bitmaps are only needed for packing the atlas
+        chars[i].data = NULL;
+    }
+
+    Image atlas = {
+        (void *)cursor, (int)width, (int)height, 1, (int)format
+    };
+    *font = LoadFontFromAtlas(atlas, key->fontSize, chars, key->charsCount);
+    free(data);
+    return true;
+}
+
+// The cache is only an optimisation, so it's skipped quietly if it can't
+// be written (a missing or partial cache is just rebuilt on the next run)
+static
+void SaveFontAtlasCache(const char *path, const FontCacheKey *key,
+                        Image atlas, const CharInfo *chars) {
+    size_t pixelsSize = GetPixelDataSize(atlas.width, atlas.height,
+                                         atlas.format);
+    size_t length = FONT_CACHE_HEADER_SIZE +
+        key->charsCount * FONT_CACHE_CHAR_SIZE + pixelsSize;
+    unsigned char *data = malloc(length);
+    if (data == NULL) {
+        return;
+    }
+
+    memcpy(data, FONT_CACHE_MAGIC, 4);
+    data[4] = FONT_CACHE_VERSION;
+    unsigned char *cursor = data + 5;
+    unsigned int keyValues[FONT_CACHE_KEY_VALUES];
+    KeyToValues(key, keyValues);
+    for (int i = 0; i < FONT_CACHE_KEY_VALUES; i++) {
+        cursor = PutU32(cursor, keyValues[i]);
+    }
+    cursor = PutU32(cursor, atlas.width);
+    cursor = PutU32(cursor, atlas.height);
+    cursor = PutU32(cursor, atlas.format);
+    for (unsigned int i = 0; i < key->charsCount; i++) {
+        cursor = PutU32(cursor, (unsigned int)chars[i].value);
+        cursor = PutU32(cursor, (unsigned int)chars[i].offsetX);
+        cursor = PutU32(cursor, (unsigned int)chars[i].offsetY);
+        cursor = PutU32(cursor, (unsigned int)chars[i].advanceX);
+        cursor = PutF32(cursor, chars[i].rec.x);
+        cursor = PutF32(cursor, chars[i].rec.y);
+        cursor = PutF32(cursor, chars[i].rec.width);
+        cursor = PutF32(cursor, chars[i].rec.height);
+    }
+    memcpy(cursor, atlas.data, pixelsSize);
+
+    FILE *file = fopen(path, "wb");
+    if (file != NULL) {
+        fwrite(data, 1, length, file);
+        fclose(file);
+    }
+    free(data);
+}
+
+Font LoadCachedFont(const char *fileName, int fontSize, int *fontChars,
+                    int charsCount, int type) {
+    // Same defaults as LoadFontEx and LoadFontData
+    if (charsCount <= 0) {
+        charsCount = 95;
+    }
+
+    struct stat fileInfo;
+    if (stat(fileName, &fileInfo) != 0) {
+        printf("WARNING: Could not read the font '%s'.\n", fileName);
+        return GetFontDefault();
+    }
+    unsigned long long fileTime = (unsigned long long)fileInfo.st_mtime;
+    FontCacheKey key = {
+        (unsigned int)fileInfo.st_size, (unsigned int)(fileTime & 0xFFFFFFFF),
+        (unsigned int)(fileTime >> 32), 0, (unsigned int)fontSize,
+        (unsigned int)type, (unsigned int)charsCount, FNV_OFFSET_BASIS
+    };
+    for (int i = 0; i < charsCount; i++) {
+        unsigned char codepoint[4];
+        PutU32(codepoint, fontChars != NULL ? fontChars[i] : i + 32);
+        key.charsHash = HashBytes(key.charsHash, codepoint, 4);
+    }
+
+    char cachePath[1024];
+    bool cacheable = GetCachePath(cachePath, sizeof(cachePath), fileName,
+                                  fontSize, type);
+    Font font;
+    if (!cacheable || !LoadFontAtlasCache(cachePath, fileName, &key, &font)) {
+        CharInfo *chars = LoadFontData(fileName, fontSize, fontChars,
+                                       charsCount, type);
+        if (chars == NULL) {
+            return GetFontDefault();
+        }
+        int padding = type == FONT_SDF ? 0 : ATLAS_PADDING;
+        Image atlas = GenImageFontAtlas(chars, charsCount, fontSize,
+                                        padding, 0);
+        // The font is only hashed when the cache is rebuilt
+        if (cacheable && HashFile(fileName, &key.fileHash)) {
+            SaveFontAtlasCache(cachePath, &key, atlas, chars);
+        }
+        font = LoadFontFromAtlas(atlas, fontSize, chars, charsCount);
+        UnloadImage(atlas);
+    }
+
+    if (type == FONT_SDF) {
+        // The distances are interpolated between texels, that's what
+        // keeps the edges smooth
+        SetTextureFilter(font.texture, FILTER_BILINEAR);
+    }
+    return font;
+}
@@ -0,0 +1,33 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FONT_CACHE_H
+#define FONT_CACHE_H
+
+#include "raylib.h"
+
+// Loads a font like LoadFontEx, or as a distance field atlas with
+// bilinear filtering (depending on the type, see FONT_DEFAULT and
+// FONT_SDF), but the rasterised and packed atlas is saved in the user's
+// cache directory, and loaded from there on later runs. The cache is used
+// only if it was made from the same font file contents, size, glyph set
+// and type, otherwise it's rebuilt. If it can't be written, the font is
+// just rasterised every time.
+Font LoadCachedFont(const char *fileName, int fontSize, int *fontChars,
+                    int charsCount, int type);
+
+#endif
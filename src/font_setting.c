@@ -16,6 +16,7 @@
  */
 
 #include "font_setting.h"
+#include "rlgl.h"
 
 void SwitchFont(FontSetting *fontSetting) {
     if (fontSetting->clearFontEnabled) {
@@ -26,3 +27,11 @@ void SwitchFont(FontSetting *fontSetting) {
         fontSetting->currentFont = &fontSetting->clearFont;
     }
 }
+
+void BeginDistanceFieldText(void) {
+    rlEnableGlyphDistanceField();
+}
+
+void EndDistanceFieldText(void) {
+    rlDisableGlyphDistanceField();
+}
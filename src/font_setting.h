@@ -29,4 +29,13 @@ typedef struct {
 
 void SwitchFont(FontSetting *fontSetting);
 
+// The fonts are distance field atlases (see LoadCachedFont), so text drawn
+// with them goes between these. Calling these when the mode is already (or
+// still) active is free, otherwise they flush the batch, so bracket a whole
+// UI pass rather than each label. Untextured shapes can be drawn in between,
+// but on drivers without instancing support textures drawn in between would
+// lose their color and have their alpha thresholded like a glyph.
+void BeginDistanceFieldText(void);
+void EndDistanceFieldText(void);
+
 #endif
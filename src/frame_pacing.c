@@ -0,0 +1,85 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "frame_pacing.h"
+#include "rlgl.h"
+#include "thread.h"
+
+// Sleeping tends to overshoot by a millisecond or so, so the end of
+// each wait is spun instead
+#define PACING_SPIN_DURATION 0.002
+// Extra time left for the unpredictable parts, like the buffer swap
+#define PACING_SAFETY_MARGIN 0.001
+// How much of the previous prediction is kept when a frame is cheaper
+#define PACING_COST_DECAY 0.95f
+
+static void WaitUntil(double time) {
+    double remaining = time - GetTime();
+    if (remaining > PACING_SPIN_DURATION) {
+        SleepSeconds(remaining - PACING_SPIN_DURATION);
+    }
+    while (GetTime() < time) {
+    }
+}
+
+FramePacer InitFramePacer(void) {
+    FramePacer pacer = { 0 };
+    int refreshRate = GetMonitorRefreshRate(0);
+    pacer.framePeriod = 1.0f / (refreshRate > 0 ? refreshRate : 60);
+    pacer.latency = -1.0f;
+    return pacer;
+}
+
+void WaitForFrameStart(FramePacer *pacer) {
+    if (pacer->enabled) {
+        double deadline = pacer->lastPresentTime + pacer->framePeriod -
+            pacer->predictedCost - PACING_SAFETY_MARGIN;
+        WaitUntil(deadline);
+    }
+    pacer->frameStartTime = GetTime();
+}
+
+void FinishPacedFrame(FramePacer *pacer) {
+    if (!pacer->enabled) {
+        return;
+    }
+
+    // Waiting for the GPU here is what keeps frames from queueing up
+    rlglFinish();
+    float cost = (float)(GetTime() - pacer->frameStartTime);
+
+    // The prediction rises right away but falls slowly, since missing
+    // the vertical blank is a lot worse than starting a bit early
+    if (cost > pacer->predictedCost) {
+        pacer->predictedCost = cost;
+    } else {
+        pacer->predictedCost = pacer->predictedCost * PACING_COST_DECAY +
+            cost * (1.0f - PACING_COST_DECAY);
+    }
+}
+
+void PresentPacedFrame(FramePacer *pacer, double inputTime) {
+    if (!pacer->enabled) {
+        pacer->latency = -1.0f;
+        return;
+    }
+
+    // With vsync, this returns when the swap has actually happened
+    rlglFinish();
+    pacer->lastPresentTime = GetTime();
+    pacer->latency = (float)((pacer->lastPresentTime - inputTime) * 1000.0);
+}
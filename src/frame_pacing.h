@@ -0,0 +1,46 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include "raylib.h"
+
+// Delays the start of each frame so that it's done just before the next
+// vertical blank, which makes the input it's drawn with as fresh as
+// possible, instead of queueing frames up behind vsync.
+typedef struct {
+    bool enabled;
+    // Seconds between vertical blanks
+    float framePeriod;
+    // Seconds from the start of a frame to the GPU finishing it
+    float predictedCost;
+    double frameStartTime;
+    double lastPresentTime;
+    // Milliseconds from input sampling to presentation, negative if unknown
+    float latency;
+} FramePacer;
+
+FramePacer InitFramePacer(void);
+// Called before sampling the input the frame is drawn with.
+void WaitForFrameStart(FramePacer *pacer);
+// Called after drawing, before EndDrawing.
+void FinishPacedFrame(FramePacer *pacer);
+// Called after EndDrawing, with the time the input was sampled at.
+void PresentPacedFrame(FramePacer *pacer, double inputTime);
+
+#endif
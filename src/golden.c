@@ -0,0 +1,133 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "golden.h"
+
+// The images are compared by luma after a 3x3 box blur, so that single
+// pixel noise doesn't matter, but anything that changes the look does.
+// A pixel differs if its luma changed more than the tolerance, and the
+// images differ if more than the given fraction of pixels do.
+#define GOLDEN_PIXEL_TOLERANCE 0.04f
+#define GOLDEN_MAX_DIFFERING_PIXELS 0.005f
+
+static
+float *GetBlurredLuma(Color *pixels, int width, int height) {
+    float *luma = (float *)malloc(width * height * sizeof(float));
+    float *blurred = (float *)malloc(width * height * sizeof(float));
+    for (int i = 0; i < width * height; i++) {
+        luma[i] = (0.299f * pixels[i].r + 0.587f * pixels[i].g +
+                   0.114f * pixels[i].b) / 255.0f;
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float sum = 0.0f;
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int sx = x + dx;
+                    int sy = y + dy;
+                    if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+                        sum += luma[sx + sy * width];
+                        count++;
+                    }
+                }
+            }
+            blurred[x + y * width] = sum / count;
+        }
+    }
+    free(luma);
+    return blurred;
+}
+
+// Returns the fraction of pixels that differ between the two images.
+static
+float CompareImages(Image a, Image b) {
+    Color *pixelsA = GetImageData(a);
+    Color *pixelsB = GetImageData(b);
+    float *lumaA = GetBlurredLuma(pixelsA, a.width, a.height);
+    float *lumaB = GetBlurredLuma(pixelsB, b.width, b.height);
+    int pixelCount = a.width * a.height;
+    int differingPixels = 0;
+    for (int i = 0; i < pixelCount; i++) {
+        if (fabsf(lumaA[i] - lumaB[i]) > GOLDEN_PIXEL_TOLERANCE) {
+            differingPixels++;
+        }
+    }
+    free(lumaB);
+    free(lumaA);
+    free(pixelsB);
+    free(pixelsA);
+    return (float)differingPixels / pixelCount;
+}
+
+bool CheckGoldenView(SDFShader *sdfShader, RenderTexture2D target,
+                     GoldenView view, const char *directory, bool update) {
+    SetSDFShaderCamera(sdfShader, view.position, view.rotation, 80.0f,
+                       view.stage);
+    DrawSDFShader(sdfShader, target);
+    // The SDF shader renders upside down, so the rows read back from
+    // the texture are already in the top-to-bottom order of images
+    Image rendered = GetTextureData(target.texture);
+
+    char referencePath[512];
+    snprintf(referencePath, sizeof(referencePath), "%s/%s.png",
+             directory, view.name);
+    if (update) {
+        bool exported = ExportImage(rendered, referencePath);
+        if (exported) {
+            printf("UPDATED %s\n", referencePath);
+        } else {
+            printf("FAIL %s: could not write %s\n", view.name, referencePath);
+        }
+        UnloadImage(rendered);
+        return exported;
+    }
+
+    bool matches = false;
+    Image reference = LoadImage(referencePath);
+    if (reference.data == NULL) {
+        printf("MISSING %s\n", referencePath);
+    } else if (reference.width != rendered.width ||
+               reference.height != rendered.height) {
+        printf("FAIL %s: the reference is %dx%d, the render %dx%d\n",
+               view.name, reference.width, reference.height,
+               rendered.width, rendered.height);
+    } else {
+        float difference = CompareImages(reference, rendered);
+        matches = difference <= GOLDEN_MAX_DIFFERING_PIXELS;
+        printf("%s %s: %.2f%% of the pixels differ\n",
+               matches ? "PASS" : "FAIL", view.name, difference * 100.0f);
+    }
+
+    // The render is saved next to the reference for comparing by eye
+    if (!matches) {
+        char actualPath[512];
+        snprintf(actualPath, sizeof(actualPath), "%s/%s-actual.png",
+                 directory, view.name);
+        if (!ExportImage(rendered, actualPath)) {
+            printf("WARNING: Could not write %s.\n", actualPath);
+        }
+    }
+
+    UnloadImage(reference);
+    UnloadImage(rendered);
+    return matches;
+}
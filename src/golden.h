@@ -0,0 +1,43 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+#include <stdbool.h>
+
+#include "sdf_shader.h"
+
+// Golden image checks: the scene is rendered from fixed views and
+// compared against reference images rendered by a known good build, so
+// that changes to the renderer can be checked for visual regressions.
+
+typedef struct {
+    char name[32];
+    float position[3];
+    float rotation[3];
+    int stage;
+} GoldenView;
+
+// Renders the view into target, and compares it to the reference image
+// in directory. With update set, the reference is replaced instead.
+// Returns false if the images differ, or the reference is missing (or
+// can't be written when updating).
+bool CheckGoldenView(SDFShader *sdfShader, RenderTexture2D target,
+                     GoldenView view, const char *directory, bool update);
+
+#endif
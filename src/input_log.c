@@ -0,0 +1,195 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "input_log.h"
+#include "little_endian.h"
+#include "raylib.h"
+
+// The file starts with these, followed by the entries, each of which
+// starts with one of the tags. All values are little-endian.
+#define INPUT_LOG_MAGIC "MTIL"
+#define INPUT_LOG_VERSION 1
+#define FRAME_TAG 'F'
+#define SETTINGS_TAG 'S'
+
+static
+void WriteU32(FILE *file, unsigned int value) {
+    unsigned char bytes[4];
+    PutU32(bytes, value);
+    fwrite(bytes, 1, 4, file);
+}
+
+static
+void WriteF32(FILE *file, float value) {
+    unsigned char bytes[4];
+    PutF32(bytes, value);
+    fwrite(bytes, 1, 4, file);
+}
+
+static
+bool ReadU32(FILE *file, unsigned int *value) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, file) != 4) {
+        return false;
+    }
+    GetU32(bytes, value);
+    return true;
+}
+
+static
+bool ReadF32(FILE *file, float *value) {
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, file) != 4) {
+        return false;
+    }
+    GetF32(bytes, value);
+    return true;
+}
+
+InputLog StartInputRecording(const char *path) {
+    InputLog log = { 0 };
+    log.file = fopen(path, "wb");
+    if (log.file == NULL) {
+        printf("WARNING: Could not open '%s' for recording input.\n", path);
+        return log;
+    }
+    fwrite(INPUT_LOG_MAGIC, 1, 4, log.file);
+    fputc(INPUT_LOG_VERSION, log.file);
+    return log;
+}
+
+InputLog StartInputReplay(const char *path) {
+    InputLog log = { 0 };
+    log.replaying = true;
+    log.file = fopen(path, "rb");
+    if (log.file == NULL) {
+        printf("WARNING: Could not open '%s' for replaying input.\n", path);
+        return log;
+    }
+    char magic[4];
+    if (fread(magic, 1, 4, log.file) != 4 ||
+        memcmp(magic, INPUT_LOG_MAGIC, 4) != 0 ||
+        fgetc(log.file) != INPUT_LOG_VERSION) {
+        printf("WARNING: '%s' is not a supported input log.\n", path);
+        fclose(log.file);
+        log.file = NULL;
+    }
+    return log;
+}
+
+void CloseInputLog(InputLog *log) {
+    if (log->file != NULL) {
+        fclose(log->file);
+        log->file = NULL;
+    }
+}
+
+InputFrame PollInputFrame(void) {
+    InputFrame frame = { 0 };
+    struct {
+        InputKey key;
+        bool active;
+    } keys[] = {
+        { INPUT_FORWARD, IsKeyDown(KEY_W) || IsKeyDown(KEY_I) },
+        { INPUT_BACKWARD, IsKeyDown(KEY_S) || IsKeyDown(KEY_K) },
+        { INPUT_STRAFE_LEFT, IsKeyDown(KEY_A) || IsKeyDown(KEY_J) },
+        { INPUT_STRAFE_RIGHT, IsKeyDown(KEY_D) || IsKeyDown(KEY_L) },
+        { INPUT_CROUCH, IsKeyDown(KEY_LEFT_CONTROL) },
+        { INPUT_TURN_LEFT, IsKeyDown(KEY_LEFT) },
+        { INPUT_TURN_RIGHT, IsKeyDown(KEY_RIGHT) },
+        { INPUT_TURN_UP, IsKeyDown(KEY_UP) },
+        { INPUT_TURN_DOWN, IsKeyDown(KEY_DOWN) },
+        { INPUT_TOGGLE_RUN, IsKeyPressed(KEY_LEFT_SHIFT) },
+        { INPUT_TOGGLE_AUTO_MOVE, IsKeyPressed(KEY_Q) },
+        { INPUT_TOGGLE_BOBBING, IsKeyPressed(KEY_B) },
+        { INPUT_SWITCH_FONT, IsKeyPressed(KEY_T) },
+        { INPUT_CYCLE_RENDER_SCALE, IsKeyPressed(KEY_R) },
+        { INPUT_TOGGLE_FOVEATION, IsKeyPressed(KEY_F) },
+        { INPUT_TOGGLE_PROFILER, IsKeyPressed(KEY_F3) },
+    };
+    for (int i = 0; i < (int)(sizeof(keys) / sizeof(keys[0])); i++) {
+        if (keys[i].active) {
+            frame.keys |= keys[i].key;
+        }
+    }
+    return frame;
+}
+
+void RecordInputFrame(InputLog *log, const InputFrame *frame) {
+    if (log->file == NULL || log->replaying) {
+        return;
+    }
+    fputc(FRAME_TAG, log->file);
+    WriteF32(log->file, frame->frameTime);
+    WriteF32(log->file, frame->mouseDeltaX);
+    WriteF32(log->file, frame->mouseDeltaY);
+    WriteU32(log->file, frame->keys);
+    log->frameCount++;
+}
+
+void RecordInputSettings(InputLog *log, const InputSettings *settings) {
+    if (log->file == NULL || log->replaying) {
+        return;
+    }
+    fputc(SETTINGS_TAG, log->file);
+    WriteF32(log->file, settings->fieldOfView);
+    WriteF32(log->file, settings->bobbingIntensity);
+    WriteU32(log->file, (unsigned int)settings->mouseSpeedX);
+    WriteU32(log->file, (unsigned int)settings->mouseSpeedY);
+    fputc(settings->showMetersWalked, log->file);
+    fputc(settings->narrationEnabled, log->file);
+    fputc(settings->clearFontEnabled, log->file);
+}
+
+InputLogEntry ReadInputLog(InputLog *log, InputFrame *frame,
+                           InputSettings *settings) {
+    if (log->file == NULL) {
+        return INPUT_LOG_END;
+    }
+
+    int tag = fgetc(log->file);
+    if (tag == FRAME_TAG) {
+        if (ReadF32(log->file, &frame->frameTime) &&
+            ReadF32(log->file, &frame->mouseDeltaX) &&
+            ReadF32(log->file, &frame->mouseDeltaY) &&
+            ReadU32(log->file, &frame->keys)) {
+            log->frameCount++;
+            return INPUT_LOG_FRAME;
+        }
+    } else if (tag == SETTINGS_TAG) {
+        unsigned int mouseSpeedX, mouseSpeedY;
+        if (ReadF32(log->file, &settings->fieldOfView) &&
+            ReadF32(log->file, &settings->bobbingIntensity) &&
+            ReadU32(log->file, &mouseSpeedX) &&
+            ReadU32(log->file, &mouseSpeedY)) {
+            settings->mouseSpeedX = (int)mouseSpeedX;
+            settings->mouseSpeedY = (int)mouseSpeedY;
+            settings->showMetersWalked = fgetc(log->file) == 1;
+            settings->narrationEnabled = fgetc(log->file) == 1;
+            int clearFontEnabled = fgetc(log->file);
+            settings->clearFontEnabled = clearFontEnabled == 1;
+            if (clearFontEnabled != EOF) {
+                return INPUT_LOG_SETTINGS;
+            }
+        }
+    }
+
+    // Either the end of the file, or a truncated entry at the end
+    return INPUT_LOG_END;
+}
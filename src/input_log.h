@@ -0,0 +1,93 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+// Records the input the main loop reads into a compact binary file, and
+// reads it back for replaying the same session, e.g. for comparing the
+// performance of two builds with the exact same walk.
+
+// The keys read during a frame. The first ones are held down, the rest
+// are pressed during the frame.
+typedef enum {
+    INPUT_FORWARD = 1 << 0,
+    INPUT_BACKWARD = 1 << 1,
+    INPUT_STRAFE_LEFT = 1 << 2,
+    INPUT_STRAFE_RIGHT = 1 << 3,
+    INPUT_CROUCH = 1 << 4,
+    INPUT_TURN_LEFT = 1 << 5,
+    INPUT_TURN_RIGHT = 1 << 6,
+    INPUT_TURN_UP = 1 << 7,
+    INPUT_TURN_DOWN = 1 << 8,
+    INPUT_TOGGLE_RUN = 1 << 9,
+    INPUT_TOGGLE_AUTO_MOVE = 1 << 10,
+    INPUT_TOGGLE_BOBBING = 1 << 11,
+    INPUT_SWITCH_FONT = 1 << 12,
+    INPUT_CYCLE_RENDER_SCALE = 1 << 13,
+    INPUT_TOGGLE_FOVEATION = 1 << 14,
+    INPUT_TOGGLE_PROFILER = 1 << 15,
+} InputKey;
+
+typedef struct {
+    float frameTime;
+    // Mouselook rotation in degrees, already scaled by the mouse speed
+    float mouseDeltaX;
+    float mouseDeltaY;
+    unsigned int keys;
+} InputFrame;
+
+// The options that can be changed in the main menu
+typedef struct {
+    float fieldOfView;
+    float bobbingIntensity;
+    int mouseSpeedX;
+    int mouseSpeedY;
+    bool showMetersWalked;
+    bool narrationEnabled;
+    bool clearFontEnabled;
+} InputSettings;
+
+typedef enum {
+    INPUT_LOG_FRAME,
+    INPUT_LOG_SETTINGS,
+    INPUT_LOG_END
+} InputLogEntry;
+
+typedef struct {
+    FILE *file;
+    bool replaying;
+    int frameCount;
+} InputLog;
+
+// The file is NULL if it couldn't be opened (or isn't an input log).
+InputLog StartInputRecording(const char *path);
+InputLog StartInputReplay(const char *path);
+void CloseInputLog(InputLog *log);
+
+// Reads the keys from the keyboard, the rest is left for the caller.
+InputFrame PollInputFrame(void);
+void RecordInputFrame(InputLog *log, const InputFrame *frame);
+void RecordInputSettings(InputLog *log, const InputSettings *settings);
+// Fills in frame or settings, depending on which is next in the log.
+InputLogEntry ReadInputLog(InputLog *log, InputFrame *frame,
+                           InputSettings *settings);
+
+#endif
@@ -0,0 +1,59 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LITTLE_ENDIAN_H
+#define LITTLE_ENDIAN_H
+
+#include <string.h>
+
+// Helpers for the little-endian values in the game's binary files (input
+// logs, the narration script and the font atlas caches). Each one writes
+// or reads 4 bytes at the cursor and returns the cursor after them.
+
+static inline
+unsigned char *PutU32(unsigned char *cursor, unsigned int value) {
+    cursor[0] = value & 0xFF;
+    cursor[1] = (value >> 8) & 0xFF;
+    cursor[2] = (value >> 16) & 0xFF;
+    cursor[3] = (value >> 24) & 0xFF;
+    return cursor + 4;
+}
+
+static inline
+unsigned char *PutF32(unsigned char *cursor, float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, 4);
+    return PutU32(cursor, bits);
+}
+
+static inline
+const unsigned char *GetU32(const unsigned char *cursor,
+                            unsigned int *value) {
+    *value = cursor[0] | (cursor[1] << 8) | (cursor[2] << 16) |
+        ((unsigned int)cursor[3] << 24);
+    return cursor + 4;
+}
+
+static inline
+const unsigned char *GetF32(const unsigned char *cursor, float *value) {
+    unsigned int bits;
+    cursor = GetU32(cursor, &bits);
+    memcpy(value, &bits, 4);
+    return cursor;
+}
+
+#endif
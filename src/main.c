@@ -23,12 +23,22 @@
 #include "raylib.h"
 #include "raymath.h"
 #include "rlgl.h"
-#include "script.h"
 #include "sdf_utils.h"
 #include "resources.h"
 #include "font_setting.h"
+#include "font_cache.h"
 #include "menu.h"
 #include "render_utils.h"
+#include "profiler.h"
+#include "sdf_shader.h"
+#include "thread.h"
+#include "frame_pacing.h"
+#include "triple_buffer.h"
+#include "input_log.h"
+#include "golden.h"
+#include "sequence.h"
+#include "text_layout.h"
+#include "narration.h"
 
 #define DEFAULT_SCREEN_WIDTH 800
 #define DEFAULT_SCREEN_HEIGHT 500
@@ -38,56 +48,244 @@
 #define RUN_SPEED 4.2f
 #define HEAD_BOB_MAGNITUDE 0.05f
 #define HEAD_BOB_FREQUENCY 1.3f
-#define COMMENT_LENGTH (DEFAULT_MAX_DISTANCE / COMMENTS_COUNT)
 #define BACKTRACKING_WARNING_DISTANCE 10.0f
 
-#define LONGEST_COMMENT_CHARACTER_COUNT_ESTIMATE 400
-#define METERS_PER_CHARACTER (DEFAULT_MAX_DISTANCE / (COMMENTS_COUNT * LONGEST_COMMENT_CHARACTER_COUNT_ESTIMATE))
+// The simulation runs at a fixed rate regardless of the framerate, and
+// the rendering interpolates between the two latest states
+#define SIMULATION_RATE 120
+#define SIMULATION_TIMESTEP (1.0f / SIMULATION_RATE)
+// Longer frames than this are slowed down instead of simulated in full
+#define MAX_FRAME_TIME 0.25f
+// Per step, about the same as the 0.2 per frame it used to be at 60 fps
+#define HEAD_BOB_SMOOTHING 0.1f
+// How often input is polled with low-latency frame pacing, which needs
+// the input to be fresh whenever the render thread decides to start
+#define LOW_LATENCY_POLL_INTERVAL 0.001f
+
+// The fractions of VIRTUAL_SCREEN_HEIGHT the scene can be rendered
+// at, the smaller ones get upscaled in DrawGameView
+#define RENDER_SCALES_COUNT 3
+const float renderScales[RENDER_SCALES_COUNT] = { 1.0f, 2.0f / 3.0f, 0.5f };
+
+// The camera path of --render-sequence, in metro space (where x is the
+// sideways offset from the middle of the tunnel): the distance along
+// the route, the sideways offset, the height, and the pitch and yaw of
+// the camera relative to the direction of the tunnel
+#define SEQUENCE_KEYFRAMES_COUNT 9
+const float sequenceScript[SEQUENCE_KEYFRAMES_COUNT][5] = {
+    { 0.0f, 0.0f, 1.75f, 0.0f, 0.0f },
+    { 200.0f, -0.6f, 1.75f, 0.0f, 8.0f },
+    { 450.0f, 0.6f, 1.75f, -5.0f, -12.0f },
+    { 800.0f, 0.0f, 1.75f, 0.0f, 0.0f },
+    { 1000.0f, -0.4f, 1.75f, 5.0f, 10.0f },
+    { 1400.0f, 0.4f, 1.75f, 0.0f, -6.0f },
+    { 1800.0f, 0.0f, 1.75f, 0.0f, 0.0f },
+    { 2050.0f, 1.5f, 1.9f, -5.0f, 20.0f },
+    { 2120.0f, 2.5f, 1.9f, 0.0f, 40.0f },
+};
+
+typedef struct {
+    // Player values
+    float cameraPosition[3];
+    float cameraRotation[3];
+    float walkingTime;
+    float headBobAmount;
+    bool autoMove;
+    bool running;
+    float metersWalked;
+    float forwardDotMovement;
+
+    // Progress values
+    int lightsStage;
+    int narrationStage;
+    float narrationStartZ;
+    float furthestDistanceSoFar;
+    float backtrackingTime;
+    bool backtracking;
+} GameState;
+
+typedef struct {
+    // Keys that are held down
+    bool forward;
+    bool backward;
+    bool strafeLeft;
+    bool strafeRight;
+    bool crouch;
+    // Degrees per second, from the arrow keys
+    float turnSpeedX;
+    float turnSpeedY;
+
+    // Keys pressed since the last step, cleared after each step
+    bool toggleRun;
+    bool toggleAutoMove;
+} GameInput;
+
+// Everything the render thread needs for drawing a frame, published by
+// the main thread after simulating
+typedef struct {
+    GameState previousState;
+    GameState state;
+    // The time state corresponds to, for interpolating towards it
+    double stateTime;
+    // The time the input was last polled
+    double inputTime;
+
+    Font font;
+    float fieldOfView;
+    bool narrationEnabled;
+    bool showMetersWalked;
+    bool showProfiler;
+    int renderScaleIndex;
+    bool foveatedRendering;
+    bool lowLatencyPacing;
+} RenderState;
+
+// The narration lines are fixed, so they're laid out all at once, and
+// again only when the font or its size changes
+typedef struct {
+    unsigned int textureId;
+    float fontSize;
+    // One for each line of the narration script
+    TextLayout *lines;
+    int lineCount;
+    TextLayout backtrackingWarning;
+} SubtitleLayouts;
+
+// The rendering resources are used by the render thread while it runs,
+// and by the main thread (for the menus) otherwise
+typedef struct {
+    TripleBuffer renderStates;
+    volatile long running;
+    Thread *thread;
+
+    SDFShader sdfShader;
+    RenderTexture2D targetTex;
+    int renderScaleIndex;
+    bool foveatedRendering;
+    bool shaderDevMode;
+    bool headless;
+    SDFShaderWatch sdfShaderWatch;
+    FramePacer pacer;
+    NarrationScript narration;
+    SubtitleLayouts subtitles;
+} Renderer;
 
 bool FileMissing(const char *path);
 void DrawWarningText(const char *text, int fontSize, int y, Color color);
 bool EnsureResourcesExist(void);
-Shader LoadSDFShader(void);
-bool ShowEpilepsyWarning(FontSetting *fontSetting);
+bool ReportMissingResources(void);
+int CheckGoldenViews(Renderer *renderer, const char *directory, bool update,
+                     float maxDistance);
+bool RenderSequence(Renderer *renderer, const char *output, int width,
+                    int height, int frameCount, float maxDistance);
+RenderTexture2D LoadSDFRenderTexture(SDFShader *sdfShader, float renderScale);
+bool ShowEpilepsyWarning(FontSetting *fontSetting, SDFShader *sdfShader);
 Rectangle GetRenderSrc(int screenWidth, int screenHeight);
 Rectangle GetRenderDest(int screenWidth, int screenHeight);
+void StepGame(GameState *state, const GameInput *input, float bobbingIntensity,
+              float maxDistance, const NarrationScript *narration);
+GameState InterpolateGameState(const GameState *previous,
+                               const GameState *current, float alpha);
+void StartRendering(Renderer *renderer);
+void StopRendering(Renderer *renderer);
+void RenderThread(void *data);
+void DrawGameFrame(Renderer *renderer);
 Vector3 GetLegalPlayerMovement(Vector3 position, Vector3 movement, float maxDistance);
 float NoiseifyPosition(float position);
-void DisplaySubtitle(Font font, const char *subtitle, float fontSize, float y);
-int GetLine(float narrationTime, int narrationStage, int linesPerScreen);
+void UpdateSubtitleLayouts(SubtitleLayouts *subtitles,
+                           const NarrationScript *narration, Font font,
+                           float fontSize);
+void UnloadSubtitleLayouts(SubtitleLayouts *subtitles);
+void DisplaySubtitle(TextLayout subtitle, float fontSize, float y);
 
-int main(void) {
-    // Player values
-    float cameraPosition[] = { 0.0f, 1.75f, 0.0f };
-    float cameraRotation[] = { 0.0f, 0.0f, 0.0f };
-    float walkingTime = 0.0f;
-    float headBobAmount = 0.0f;
-    bool autoMove = false;
-    bool running = false;
-    float metersWalked = 0.0f;
+int main(int argc, char **argv) {
+    // Simulation values
+    GameState state = {
+        .cameraPosition = { 0.0f, 1.75f, 0.0f },
+        .narrationStage = -1,
+    };
+    GameState previousState = state;
+    GameInput input = { 0 };
+    float simulationTime = 0.0f;
 
     // Mouselook values
-    int mouseX = -1;
-    int mouseY = -1;
     bool mouseLookEnabled = false;
     bool narrationEnabled = true;
 
-    // Progress values
-    int lightsStage = 0;
-    int narrationStage = -1;
-    float narrationStartZ = 0.0f;
-    float furthestDistanceSoFar = cameraPosition[2];
-    float backtrackingTime = 0.0f;
-
     // Runtime configurable options
     float fieldOfView = 80.0f;
     float bobbingIntensity = 1.0f;
     int mouseSpeedX = 150;
     int mouseSpeedY = 150;
     bool showMetersWalked = false;
+    int renderScaleIndex = 0;
+    bool foveatedRendering = true;
+    bool showProfiler = false;
+    bool lowLatencyPacing = false;
+
+    // Development options
+    bool shaderDevMode = false;
+    InputLog inputLog = { 0 };
+    bool replaying = false;
+    bool headless = false;
+    int headlessFrameCount = 0;
+    const char *goldenDirectory = NULL;
+    bool updateGoldenImages = false;
+    const char *sequenceOutput = NULL;
+    int sequenceWidth = 0;
+    int sequenceHeight = 0;
+    int sequenceFrameCount = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--shader-dev") == 0) {
+            // Reload the SDF shader when it changes, and time it
+            shaderDevMode = true;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            // Record the input of the walk into a file
+            CloseInputLog(&inputLog);
+            inputLog = StartInputRecording(argv[++i]);
+            replaying = false;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            // Replay a recorded walk as fast as possible, and time it
+            CloseInputLog(&inputLog);
+            inputLog = StartInputReplay(argv[++i]);
+            replaying = inputLog.file != NULL;
+        } else if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            // Render the scene the given amount of frames in a hidden
+            // window, and time it
+            headless = true;
+            headlessFrameCount = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "--golden") == 0 ||
+                    strcmp(argv[i], "--golden-update") == 0) && i + 1 < argc) {
+            // Compare the scene from fixed views to the reference images
+            // in a directory (or update them), without drawing any frames
+            updateGoldenImages = strcmp(argv[i], "--golden-update") == 0;
+            goldenDirectory = argv[++i];
+            headless = true;
+            headlessFrameCount = 0;
+        } else if (strcmp(argv[i], "--render-sequence") == 0 && i + 4 < argc) {
+            // Render the frames of a fly-through of the whole route,
+            // at any resolution, without drawing any frames of the game
+            sequenceOutput = argv[++i];
+            sequenceWidth = atoi(argv[++i]);
+            sequenceHeight = atoi(argv[++i]);
+            sequenceFrameCount = atoi(argv[++i]);
+            headless = true;
+            headlessFrameCount = 0;
+        }
+    }
+    // Replays and headless runs skip the interactive screens, and run
+    // as fast as they can
+    bool interactive = !replaying && !headless;
 
     SetTraceLogLevel(LOG_WARNING);
-    SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
+    unsigned int configFlags = FLAG_WINDOW_RESIZABLE;
+    if (interactive) {
+        configFlags |= FLAG_VSYNC_HINT;
+    }
+    if (headless) {
+        configFlags |= FLAG_WINDOW_HIDDEN;
+    }
+    SetConfigFlags(configFlags);
     SetExitKey(KEY_F4);
     InitWindow(DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT,
                "A Walk In A Metro Tunnel");
@@ -95,12 +293,22 @@ int main(void) {
     Image windowIcon = LoadImage(resourcePaths[RESOURCE_ICON]);
     SetWindowIcon(windowIcon);
 
-    if (EnsureResourcesExist()) {
-        return 0;
+    if (interactive) {
+        if (EnsureResourcesExist()) {
+            return 0;
+        }
+    } else if (ReportMissingResources()) {
+        CloseWindow();
+        return 1;
     }
 
-    Font vt323Font = LoadFontEx(resourcePaths[RESOURCE_VT323], 72, 0, 0);
-    Font openSansFont = LoadFontEx(resourcePaths[RESOURCE_OPEN_SANS], 72, 0, 0);
+    // Distance field atlases stay sharp when scaled up, so a smaller base
+    // size covers both the subtitles and the large menu and warning text.
+    // The atlases are cached on disk after the first run.
+    Font vt323Font = LoadCachedFont(resourcePaths[RESOURCE_VT323], 48,
+                                    NULL, 0, FONT_SDF);
+    Font openSansFont = LoadCachedFont(resourcePaths[RESOURCE_OPEN_SANS], 48,
+                                       NULL, 0, FONT_SDF);
     FontSetting fontSetting = {
         vt323Font, openSansFont, false, NULL /* This is set immediately after */
     };
@@ -110,302 +318,445 @@ int main(void) {
      * mainFont because MSVC complains if you try to set currentFont
      * to &vt323Font in the initializer */
 
-    Shader sdfShader = LoadSDFShader();
-    int resolutionLocation = GetShaderLocation(sdfShader, "resolution");
-    int cameraPositionLocation = GetShaderLocation(sdfShader, "cameraPosition");
-    int cameraRotationLocation = GetShaderLocation(sdfShader, "cameraRotation");
-    int cameraFieldOfViewLocation = GetShaderLocation(sdfShader, "cameraFieldOfView");
-    int lightsStageLocation = GetShaderLocation(sdfShader, "stage");
-    int maxDistanceLocation = GetShaderLocation(sdfShader, "maxDistance");
-
-    RenderTexture2D targetTex = LoadRenderTexture(VIRTUAL_SCREEN_HEIGHT * 2,
-                                                  VIRTUAL_SCREEN_HEIGHT);
-    float resolution[] = { (float)VIRTUAL_SCREEN_HEIGHT * 2,
-                           (float)VIRTUAL_SCREEN_HEIGHT };
-    SetShaderValue(sdfShader, resolutionLocation, resolution, UNIFORM_VEC2);
+    // The ray marching shader takes a while to compile, so it's done
+    // while the epilepsy warning is being shown
+    Renderer renderer = { 0 };
+    renderer.narration = LoadNarrationScript(resourcePaths[RESOURCE_SCRIPT]);
+    renderer.renderStates = LoadTripleBuffer(sizeof(RenderState));
+    renderer.pacer = InitFramePacer();
+    renderer.sdfShader = LoadSDFShaderAsync(resourcePaths[RESOURCE_SHADER]);
+    renderer.renderScaleIndex = renderScaleIndex;
+    renderer.targetTex = LoadSDFRenderTexture(&renderer.sdfShader,
+                                              renderScales[renderScaleIndex]);
+    LoadUpscalingShaders(resourcePaths[RESOURCE_EASU_SHADER],
+                         resourcePaths[RESOURCE_RCAS_SHADER]);
     float maxDistance = DEFAULT_MAX_DISTANCE;
-    SetShaderValue(sdfShader, maxDistanceLocation, &maxDistance, UNIFORM_FLOAT);
+    SetSDFShaderMaxDistance(&renderer.sdfShader, maxDistance);
+    renderer.foveatedRendering = foveatedRendering;
+    SetSDFShaderFoveated(&renderer.sdfShader, foveatedRendering);
 
-    bool windowClosedInMenu = ShowEpilepsyWarning(&fontSetting);
-    bool firstMainMenuShown = false;
-    bool firstGameRenderDone = false;
+    // Replays skip the interactive screens, the recording starts after them
+    bool windowClosedInMenu = false;
+    if (interactive) {
+        windowClosedInMenu = ShowEpilepsyWarning(&fontSetting,
+                                                 &renderer.sdfShader);
+    }
+    FinishLoadingSDFShader(&renderer.sdfShader);
 
-    float lastTime = (float)GetTime();
-    while (!WindowShouldClose() && !windowClosedInMenu) {
-        float currentTime = (float)GetTime();
-        float delta = currentTime - lastTime;
-        delta = delta > 0.03f ? 0.03f : delta;
-        lastTime = currentTime;
+    int exitCode = 0;
+    if (goldenDirectory != NULL) {
+        int failures = CheckGoldenViews(&renderer, goldenDirectory,
+                                        updateGoldenImages, maxDistance);
+        exitCode = failures > 0 ? 1 : 0;
+    }
+    if (sequenceOutput != NULL) {
+        bool rendered = RenderSequence(&renderer, sequenceOutput,
+                                       sequenceWidth, sequenceHeight,
+                                       sequenceFrameCount, maxDistance);
+        exitCode = rendered ? 0 : 1;
+    }
 
-        // Configuration keys
-        if (IsKeyPressed(KEY_B)) {
-            // Toggle bobbing
-            bobbingIntensity = bobbingIntensity > 0.5f ? 0.0f : 1.0f;
-        }
+    renderer.shaderDevMode = shaderDevMode;
+    if (shaderDevMode && !windowClosedInMenu) {
+        renderer.sdfShaderWatch =
+            WatchSDFShader(resourcePaths[RESOURCE_SHADER],
+                           &renderer.sdfShader);
+    }
 
-        if (IsKeyPressed(KEY_T)) {
-            SwitchFont(&fontSetting);
-        }
+    // The main menu is shown on top of the first frame of the game
+    if (!windowClosedInMenu && interactive) {
+        SetSDFShaderCamera(&renderer.sdfShader, state.cameraPosition,
+                           state.cameraRotation, fieldOfView,
+                           state.lightsStage);
+        DrawSDFShader(&renderer.sdfShader, renderer.targetTex);
+        windowClosedInMenu =
+            ShowMainMenu(&fontSetting, renderer.targetTex.texture,
+                         false, &fieldOfView, &bobbingIntensity,
+                         &mouseSpeedX, &mouseSpeedY, &showMetersWalked,
+                         &narrationEnabled);
+    }
 
-        // Menu access
-        if (IsKeyPressed(KEY_ESCAPE) || (!firstMainMenuShown && firstGameRenderDone)) {
+    // From here on, this thread polls input and runs the simulation at a
+    // steady rate, while the render thread draws whatever the latest
+    // published state is
+    RenderState *renderState =
+        (RenderState *)GetTripleBufferWriteSlot(&renderer.renderStates);
+    renderState->previousState = previousState;
+    renderState->state = state;
+    renderState->stateTime = GetTime();
+    renderState->font = *fontSetting.currentFont;
+    renderState->fieldOfView = fieldOfView;
+    renderState->renderScaleIndex = renderScaleIndex;
+    renderState->foveatedRendering = foveatedRendering;
+    PublishTripleBuffer(&renderer.renderStates);
+    InputSettings settings = {
+        fieldOfView, bobbingIntensity, mouseSpeedX, mouseSpeedY,
+        showMetersWalked, narrationEnabled, fontSetting.clearFontEnabled
+    };
+    RecordInputSettings(&inputLog, &settings);
+    renderer.headless = headless;
+    if (!interactive) {
+        // Every frame is drawn on this thread, so that each simulated
+        // (or replayed) frame gets drawn exactly once
+        SetManualEventPolling(true);
+    } else if (!windowClosedInMenu) {
+        StartRendering(&renderer);
+    }
+
+    bool recording = inputLog.file != NULL && !replaying;
+    double lastTime = GetTime();
+    double benchmarkStartTime = lastTime;
+    int framesDrawn = 0;
+    while (!WindowShouldClose() && !windowClosedInMenu &&
+           (!headless || framesDrawn < headlessFrameCount)) {
+        PollWindowEvents();
+
+        // Menu access, only when someone is there to use it
+        if (IsKeyPressed(KEY_ESCAPE) && interactive) {
             mouseLookEnabled = false;
             EnableCursor();
+            // The menu draws on this thread, so it needs the context back
+            StopRendering(&renderer);
             windowClosedInMenu |=
-                ShowMainMenu(&fontSetting, targetTex.texture,
-                             firstMainMenuShown, &fieldOfView, &bobbingIntensity,
+                ShowMainMenu(&fontSetting, renderer.targetTex.texture,
+                             true, &fieldOfView, &bobbingIntensity,
                              &mouseSpeedX, &mouseSpeedY, &showMetersWalked,
                              &narrationEnabled);
-            firstMainMenuShown = true;
+            if (!windowClosedInMenu) {
+                StartRendering(&renderer);
+            }
+            settings = (InputSettings){
+                fieldOfView, bobbingIntensity, mouseSpeedX, mouseSpeedY,
+                showMetersWalked, narrationEnabled,
+                fontSetting.clearFontEnabled
+            };
+            RecordInputSettings(&inputLog, &settings);
+            // The time spent in the menu shouldn't be simulated
+            lastTime = GetTime();
         }
 
-        // Turn around
-        if (IsKeyDown(KEY_LEFT)) {
-            cameraRotation[1] -= delta * 120.0f * (mouseSpeedX / 100.0f);
-            if (cameraRotation[1] < 0.0) {
-                cameraRotation[1] += 360.0f;
+        // This frame's input, either from the keyboard and the mouse, or
+        // from the replayed input log
+        double currentTime = GetTime();
+        InputFrame frame;
+        if (replaying) {
+            // Settings entries precede the frame they were changed on
+            InputLogEntry entry;
+            while ((entry = ReadInputLog(&inputLog, &frame, &settings))
+                   == INPUT_LOG_SETTINGS) {
+                fieldOfView = settings.fieldOfView;
+                bobbingIntensity = settings.bobbingIntensity;
+                mouseSpeedX = settings.mouseSpeedX;
+                mouseSpeedY = settings.mouseSpeedY;
+                showMetersWalked = settings.showMetersWalked;
+                narrationEnabled = settings.narrationEnabled;
+                if (settings.clearFontEnabled != fontSetting.clearFontEnabled) {
+                    SwitchFont(&fontSetting);
+                }
             }
-        }
-        if (IsKeyDown(KEY_RIGHT)) {
-            cameraRotation[1] += delta * 120.0f * (mouseSpeedX / 100.0f);
-            if (cameraRotation[1] > 360) {
-                cameraRotation[1] -= 360.0f;
+            if (entry == INPUT_LOG_END) {
+                break;
             }
-        }
-        if (IsKeyDown(KEY_UP)) {
-            cameraRotation[0] -= delta * 90.0f * (mouseSpeedY / 100.0f);
-            if (cameraRotation[0] < -90.0) {
-                cameraRotation[0] = -90.0f;
+        } else {
+            frame = PollInputFrame();
+            float frameTime = (float)(currentTime - lastTime);
+            frame.frameTime = frameTime > MAX_FRAME_TIME ? MAX_FRAME_TIME : frameTime;
+
+            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+                mouseLookEnabled = true;
+                DisableCursor();
             }
-        }
-        if (IsKeyDown(KEY_DOWN)) {
-            cameraRotation[0] += delta * 90.0f * (mouseSpeedY / 100.0f);
-            if (cameraRotation[0] > 90.0) {
-                cameraRotation[0] = 90.0f;
+            // All the (raw, if supported) motion since the last poll,
+            // so none of it is lost between the simulation steps
+            Vector2 mouseMotion = GetMouseMotion();
+            if (mouseLookEnabled) {
+                frame.mouseDeltaX = mouseMotion.x / GetScreenHeight() * mouseSpeedX;
+                frame.mouseDeltaY = mouseMotion.y / GetScreenHeight() * mouseSpeedY;
             }
-        }
 
-        // Mouselook
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            mouseLookEnabled = true;
-            DisableCursor();
-        }
-        if (mouseLookEnabled) {
-            float dx = (float)(GetMouseX() - mouseX) / GetScreenHeight() * mouseSpeedX;
-            float dy = (float)(GetMouseY() - mouseY) / GetScreenHeight() * mouseSpeedY;
-            mouseX = GetMouseX();
-            mouseY = GetMouseY();
-            cameraRotation[0] = Clamp(cameraRotation[0] + dy, -90.0f, 90.0f);
-            cameraRotation[1] += dx;
-        } else {
-            mouseX = GetMouseX();
-            mouseY = GetMouseY();
+            RecordInputFrame(&inputLog, &frame);
         }
+        lastTime = currentTime;
 
-        // Run toggle
-        if (IsKeyPressed(KEY_LEFT_SHIFT)) {
-            running = !running;
+        // Configuration keys, the rendering related ones are applied by
+        // the render thread when it sees them in the published state
+        if (frame.keys & INPUT_TOGGLE_BOBBING) {
+            // Toggle bobbing
+            bobbingIntensity = bobbingIntensity > 0.5f ? 0.0f : 1.0f;
         }
 
-        // Walk
-        float r = cameraRotation[1] * DEG2RAD;
-        bool walking = autoMove;
-        float speed = running ? RUN_SPEED : WALK_SPEED;
-        Vector3 movement = { 0.0f, 0.0f, 0.0f };
-        if (IsKeyPressed(KEY_Q)) {
-            autoMove = !autoMove;
-        }
-        if (autoMove) {
-            movement.x += delta * speed * sinf(r);
-            movement.z += delta * speed * cosf(r);
-        }
-        if (IsKeyDown(KEY_W) || IsKeyDown(KEY_I)) {
-            movement.x += delta * speed * sinf(r);
-            movement.z += delta * speed * cosf(r);
-            walking = true;
-            autoMove = false;
+        if (frame.keys & INPUT_SWITCH_FONT) {
+            SwitchFont(&fontSetting);
         }
-        if (IsKeyDown(KEY_S) || IsKeyDown(KEY_K)) {
-            movement.x -= delta * speed * sinf(r);
-            movement.z -= delta * speed * cosf(r);
-            walking = true;
-            autoMove = false;
+
+        if (frame.keys & INPUT_CYCLE_RENDER_SCALE) {
+            // Cycle the render resolution
+            renderScaleIndex = (renderScaleIndex + 1) % RENDER_SCALES_COUNT;
         }
-        if (IsKeyDown(KEY_D) || IsKeyDown(KEY_L)) {
-            movement.x += delta * speed * cosf(r);
-            movement.z += delta * speed * -sinf(r);
-            walking = true;
+
+        if (frame.keys & INPUT_TOGGLE_FOVEATION) {
+            // Toggle foveated rendering
+            foveatedRendering = !foveatedRendering;
         }
-        if (IsKeyDown(KEY_A) || IsKeyDown(KEY_J)) {
-            movement.x -= delta * speed * cosf(r);
-            movement.z -= delta * speed * -sinf(r);
-            walking = true;
+
+        if (frame.keys & INPUT_TOGGLE_PROFILER) {
+            showProfiler = !showProfiler;
         }
 
-        // The actual movement
-        Vector3 position = { cameraPosition[0], 0.0f, cameraPosition[2] };
-        // ..on the forward axis
-        Vector3 forward = GetPathForward(position, maxDistance);
-        float forwardDotMovement = Vector3DotProduct(forward, movement);
-        forward = Vector3Scale(forward, forwardDotMovement);
-        position = GetLegalPlayerMovement(position, forward, maxDistance);
-        // ..on the right axis
-        Vector3 right = GetPathNormal(position, maxDistance);
-        right = Vector3Scale(right, Vector3DotProduct(right, movement));
-        position = GetLegalPlayerMovement(position, right, maxDistance);
-        // ..and finally applying it to the actual coordinates
-        float previousX = cameraPosition[0];
-        float previousZ = cameraPosition[2];
-        cameraPosition[0] = position.x;
-        cameraPosition[2] = Clamp(position.z, -10.0f, maxDistance + 10.0f);
-        float deltaX = cameraPosition[0] - previousX;
-        float deltaZ = cameraPosition[2] - previousZ;
-        metersWalked += sqrtf(deltaX * deltaX + deltaZ * deltaZ);
-
-        if (walking) {
-            walkingTime += delta;
-        } else {
-            walkingTime = 0.0f;
+        // Frame pacing isn't part of the walk, so it's left out of replays
+        if (IsKeyPressed(KEY_P) && interactive) {
+            lowLatencyPacing = !lowLatencyPacing;
         }
 
-        // Crouch and bob
-        cameraPosition[1] -= headBobAmount;
-        float bobTime = walkingTime * 6.28f * HEAD_BOB_FREQUENCY *
-            (running ? 1.4f : 1.0f);
-        float targetBob = sinf(bobTime) * HEAD_BOB_MAGNITUDE * bobbingIntensity;
-        headBobAmount = Lerp(headBobAmount, targetBob, 0.2f);
-        Vector3 cameraPositionVec = {
-            cameraPosition[0], cameraPosition[1], cameraPosition[2]
-        };
-        float relativeX = TransformToMetroSpace(cameraPositionVec, maxDistance).x;
-        bool onPlank = fabs(relativeX) < 1.0;
-        bool onRail = fabs(relativeX) > 0.762 - 0.05 &&
-            fabs(relativeX) < 0.762 + 0.05;
-        float height = onRail ? 0.3f : (onPlank ? 0.1f : 0.0f);
-        if (IsKeyDown(KEY_LEFT_CONTROL)) {
-            height += 0.9f;
-        } else {
-            height += 1.75f;
+        // Mouselook, applied to both states right away so it doesn't
+        // wait for the next simulation step
+        GameState *states[] = { &previousState, &state };
+        for (int i = 0; i < 2; i++) {
+            float *rotation = states[i]->cameraRotation;
+            rotation[0] = Clamp(rotation[0] + frame.mouseDeltaY, -90.0f, 90.0f);
+            rotation[1] += frame.mouseDeltaX;
         }
-        cameraPosition[1] = Lerp(cameraPosition[1], height, 10.0f * delta);
-        cameraPosition[1] += headBobAmount;
 
-        // Activate location-based actions
-        float lightMaxDistance = maxDistance - 9.0f;
-        float triggerPosition = Clamp(NoiseifyPosition(cameraPosition[2]),
-                                      0.0f, lightMaxDistance);
-        if (triggerPosition > (lightsStage + 1) * 9) {
-            lightsStage++;
+        // Movement input, for the simulation steps
+        input.forward = (frame.keys & INPUT_FORWARD) != 0;
+        input.backward = (frame.keys & INPUT_BACKWARD) != 0;
+        input.strafeRight = (frame.keys & INPUT_STRAFE_RIGHT) != 0;
+        input.strafeLeft = (frame.keys & INPUT_STRAFE_LEFT) != 0;
+        input.crouch = (frame.keys & INPUT_CROUCH) != 0;
+        input.turnSpeedX = 0.0f;
+        input.turnSpeedY = 0.0f;
+        if (frame.keys & INPUT_TURN_LEFT) {
+            input.turnSpeedX -= 120.0f * (mouseSpeedX / 100.0f);
         }
-        if (cameraPosition[2] > (narrationStage + 1) * COMMENT_LENGTH + 6) {
-            narrationStartZ = (narrationStage + 1) * COMMENT_LENGTH + 6;
-            narrationStage++;
+        if (frame.keys & INPUT_TURN_RIGHT) {
+            input.turnSpeedX += 120.0f * (mouseSpeedX / 100.0f);
         }
-
-        // Backtracking check
-        bool backtracking = false;
-        if (cameraPosition[2] > furthestDistanceSoFar) {
-            furthestDistanceSoFar = cameraPosition[2];
-            backtrackingTime = 0.0f;
-        } else if (furthestDistanceSoFar - cameraPosition[2] > BACKTRACKING_WARNING_DISTANCE) {
-            backtracking = true;
-            backtrackingTime += delta;
+        if (frame.keys & INPUT_TURN_UP) {
+            input.turnSpeedY -= 90.0f * (mouseSpeedY / 100.0f);
+        }
+        if (frame.keys & INPUT_TURN_DOWN) {
+            input.turnSpeedY += 90.0f * (mouseSpeedY / 100.0f);
+        }
+        input.toggleRun |= (frame.keys & INPUT_TOGGLE_RUN) != 0;
+        input.toggleAutoMove |= (frame.keys & INPUT_TOGGLE_AUTO_MOVE) != 0;
+        // Simulate
+        simulationTime += frame.frameTime;
+        while (simulationTime >= SIMULATION_TIMESTEP) {
+            previousState = state;
+            StepGame(&state, &input, bobbingIntensity, maxDistance,
+                     &renderer.narration);
+            input.toggleRun = false;
+            input.toggleAutoMove = false;
+            simulationTime -= SIMULATION_TIMESTEP;
         }
 
-        BeginDrawing();
-        ClearBackground((Color){ 0x20, 0x24, 0x30, 0xFF });
+        // Publish the results for the render thread
+        renderState =
+            (RenderState *)GetTripleBufferWriteSlot(&renderer.renderStates);
+        renderState->previousState = previousState;
+        renderState->state = state;
+        renderState->stateTime = currentTime - simulationTime;
+        renderState->inputTime = currentTime;
+        renderState->font = *fontSetting.currentFont;
+        renderState->fieldOfView = fieldOfView;
+        renderState->narrationEnabled = narrationEnabled;
+        renderState->showMetersWalked = showMetersWalked;
+        renderState->showProfiler = showProfiler;
+        renderState->renderScaleIndex = renderScaleIndex;
+        renderState->foveatedRendering = foveatedRendering;
+        renderState->lowLatencyPacing = lowLatencyPacing;
+        PublishTripleBuffer(&renderer.renderStates);
 
-        // Upload uniforms
-        SetShaderValue(sdfShader, cameraPositionLocation,
-                       cameraPosition, UNIFORM_VEC3);
-        SetShaderValue(sdfShader, cameraRotationLocation,
-                       cameraRotation, UNIFORM_VEC3);
-        SetShaderValue(sdfShader, cameraFieldOfViewLocation,
-                       &fieldOfView, UNIFORM_FLOAT);
-        SetShaderValue(sdfShader, lightsStageLocation,
-                       &lightsStage, UNIFORM_INT);
-
-        // Draw the scene (to the render texture)
-        BeginTextureMode(targetTex);
-        BeginShaderMode(sdfShader);
-        DrawRectangle(0, 0, VIRTUAL_SCREEN_HEIGHT * 2, VIRTUAL_SCREEN_HEIGHT,
-                      (Color){0xFF, 0x00, 0xFF, 0xFF});
-        EndShaderMode();
-        EndTextureMode();
-
-        // Draw the render texture to the screen
-        if (!firstGameRenderDone) {
-            // Sorry about this hack, the idea is as following:
-
-            // 1. Show warning about noise and flashing graphics
-            // 2. Render 1 frame of the game    <- you're here
-            // 3. Render main menu, with the frame rendered in step 2 in the bg
-            // 4. Continue as normal
-
-            // As you might be able to guess, this branch exists to
-            // make step 2 not cause a flicker. Yes, this should be
-            // done in a more elegant way, but honestly, this is like,
-            // one of the last things I'm going to write in this
-            // codebase. You'll live.
-
-            firstGameRenderDone = true;
+        if (renderer.thread == NULL) {
+            DrawGameFrame(&renderer);
+            framesDrawn++;
+        } else if (lowLatencyPacing && !recording) {
+            SleepSeconds(LOW_LATENCY_POLL_INTERVAL);
         } else {
-            DrawGameView(targetTex.texture);
+            // Wait for the next simulation step to be due, also with
+            // low-latency pacing while recording, as every poll is an
+            // entry in the input log
+            SleepSeconds(SIMULATION_TIMESTEP - simulationTime);
         }
+    }
+
+    if (!interactive && framesDrawn > 0) {
+        double benchmarkDuration = GetTime() - benchmarkStartTime;
+        printf("INFO: Drew %d frames in %.2f s (%.3f ms per frame).\n",
+               framesDrawn, benchmarkDuration,
+               benchmarkDuration * 1000.0 / framesDrawn);
+    }
+    CloseInputLog(&inputLog);
+
+    StopRendering(&renderer);
+    UnloadTripleBuffer(&renderer.renderStates);
+    UnloadUpscalingShaders();
+    UnloadRenderTexture(renderer.targetTex);
+    UnloadTexture(renderer.targetTex.texture);
+    UnwatchSDFShader(&renderer.sdfShaderWatch);
+    UnloadSDFShader(renderer.sdfShader);
+    UnloadSubtitleLayouts(&renderer.subtitles);
+    UnloadNarrationScript(&renderer.narration);
+    UnloadFont(openSansFont);
+    UnloadFont(vt323Font);
+
+    CloseWindow();
+    return exitCode;
+}
+
+void StartRendering(Renderer *renderer) {
+    // Window events can only be polled on the main thread, so they're
+    // polled there separately, and the context is handed over
+    SetManualEventPolling(true);
+    SetGraphicsContextCurrent(false);
+    AtomicStore(&renderer->running, 1);
+    renderer->thread = StartThread(RenderThread, renderer);
+    if (renderer->thread == NULL) {
+        printf("WARNING: Render thread could not be started, "
+               "rendering on the main thread.\n");
+        SetGraphicsContextCurrent(true);
+    }
+}
+
+void StopRendering(Renderer *renderer) {
+    if (renderer->thread != NULL) {
+        AtomicStore(&renderer->running, 0);
+        JoinThread(renderer->thread);
+        renderer->thread = NULL;
+        SetGraphicsContextCurrent(true);
+    }
+    SetManualEventPolling(false);
+}
+
+void RenderThread(void *data) {
+    Renderer *renderer = (Renderer *)data;
+    SetGraphicsContextCurrent(true);
+    while (AtomicLoad(&renderer->running)) {
+        DrawGameFrame(renderer);
+    }
+    SetGraphicsContextCurrent(false);
+}
+
+void DrawGameFrame(Renderer *renderer) {
+    // With low-latency pacing, this waits until just before the frame
+    // has to start, so the state read after it is as fresh as possible
+    WaitForFrameStart(&renderer->pacer);
+    const RenderState *renderState =
+        (const RenderState *)ReadTripleBuffer(&renderer->renderStates);
+    renderer->pacer.enabled = renderState->lowLatencyPacing;
+
+    UpdateProfiler();
+
+    // Apply configuration changes
+    if (renderState->renderScaleIndex != renderer->renderScaleIndex) {
+        renderer->renderScaleIndex = renderState->renderScaleIndex;
+        UnloadRenderTexture(renderer->targetTex);
+        renderer->targetTex =
+            LoadSDFRenderTexture(&renderer->sdfShader,
+                                 renderScales[renderer->renderScaleIndex]);
+    }
 
-        // Narration text display
-        int screenHeight = GetScreenHeight();
-        float fontSize = screenHeight / 240.0f * 12.0f;
-        if (narrationStage >= 0 && narrationStage < COMMENTS_COUNT
-            && narrationEnabled) {
-            float narrationTime = cameraPosition[2] - narrationStartZ;
-            int linesPerScreen = 2;
-            int lineIndex = GetLine(narrationTime, narrationStage,
-                                    linesPerScreen);
-            if (lineIndex != -1) {
-                float y = screenHeight * 0.9f - fontSize;
-                for (int i = 0; i < linesPerScreen; i++) {
-                    int index = lineIndex + i;
-                    if (index >= 0 && index < COMMENT_LINES) {
-                        const char *line =
-                            narratorComments[narrationStage][index];
-                        DisplaySubtitle(*fontSetting.currentFont,
-                                        line, fontSize, y);
-                        y += fontSize;
-                    }
+    if (renderState->foveatedRendering != renderer->foveatedRendering) {
+        renderer->foveatedRendering = renderState->foveatedRendering;
+        SetSDFShaderFoveated(&renderer->sdfShader, renderer->foveatedRendering);
+    }
+
+    if (renderer->shaderDevMode) {
+        ReloadChangedSDFShader(&renderer->sdfShaderWatch, &renderer->sdfShader);
+    }
+
+    // The simulation runs ahead, so the rendered state is blended
+    // towards the latest one as time passes
+    float alpha = (float)((GetTime() - renderState->stateTime) /
+                          SIMULATION_TIMESTEP);
+    GameState state = InterpolateGameState(&renderState->previousState,
+                                           &renderState->state,
+                                           Clamp(alpha, 0.0f, 1.0f));
+    float *cameraPosition = state.cameraPosition;
+    Font font = renderState->font;
+
+    if (renderer->headless) {
+        // There's nothing to show the frame on, so only the scene is
+        // rendered, and waited on to keep the frame times honest
+        SetSDFShaderCamera(&renderer->sdfShader, cameraPosition,
+                           state.cameraRotation, renderState->fieldOfView,
+                           state.lightsStage);
+        BeginProfilerPass(PROFILER_PASS_SDF);
+        DrawSDFShader(&renderer->sdfShader, renderer->targetTex);
+        EndProfilerPass();
+        rlglFinish();
+        return;
+    }
+
+    BeginDrawing();
+    ClearBackground((Color){ 0x20, 0x24, 0x30, 0xFF });
+
+    // Upload uniforms
+    SetSDFShaderCamera(&renderer->sdfShader, cameraPosition,
+                       state.cameraRotation, renderState->fieldOfView,
+                       state.lightsStage);
+
+    // Draw the scene (to the render texture)
+    BeginProfilerPass(PROFILER_PASS_SDF);
+    DrawSDFShader(&renderer->sdfShader, renderer->targetTex);
+    EndProfilerPass();
+
+    // Draw the render texture to the screen
+    BeginProfilerPass(PROFILER_PASS_GAME_VIEW);
+    DrawGameView(renderer->targetTex.texture);
+    EndProfilerPass();
+
+    // Narration text display
+    BeginProfilerPass(PROFILER_PASS_UI);
+    BeginDistanceFieldText();
+    int screenHeight = GetScreenHeight();
+    float fontSize = screenHeight / 240.0f * 12.0f;
+    const NarrationScript *narration = &renderer->narration;
+    UpdateSubtitleLayouts(&renderer->subtitles, narration, font, fontSize);
+    int narrationStage = state.narrationStage;
+    if (narrationStage >= 0 && narrationStage < narration->stageCount
+        && renderState->narrationEnabled) {
+        float narrationTime = cameraPosition[2] - state.narrationStartZ;
+        int linesPerScreen = 2;
+        int lineIndex = GetNarrationLine(narration, narrationStage,
+                                         narrationTime, linesPerScreen);
+        if (lineIndex != -1) {
+            float y = screenHeight * 0.9f - fontSize;
+            TextLayout *stageLines = &renderer->subtitles.lines[
+                narrationStage * narration->linesPerStage];
+            for (int i = 0; i < linesPerScreen; i++) {
+                int index = lineIndex + i;
+                if (index >= 0 && index < narration->linesPerStage) {
+                    DisplaySubtitle(stageLines[index], fontSize, y);
+                    y += fontSize;
                 }
             }
         }
+    }
 
-        // Warning for the player that they're going backwards
-        if (backtracking && forwardDotMovement < 0.0) {
-            DisplaySubtitle(*fontSetting.currentFont,
-                            "Warning: You're going the wrong way.",
-                            fontSize, 50.0f);
-        }
+    // Warning for the player that they're going backwards
+    if (state.backtracking && state.forwardDotMovement < 0.0) {
+        DisplaySubtitle(renderer->subtitles.backtrackingWarning,
+                        fontSize, 50.0f);
+    }
 
-        if (showMetersWalked) {
-            const char *text = TextFormat("%4.0fm", metersWalked);
-            DrawTextEx(*fontSetting.currentFont, text,
-                       (Vector2){ 30.0f, 30.0f },
-                       fontSize, 0.0f, YELLOW);
-        }
+    if (renderState->showMetersWalked) {
+        const char *text = TextFormat("%4.0fm", state.metersWalked);
+        DrawTextEx(font, text, (Vector2){ 30.0f, 30.0f },
+                   fontSize, 0.0f, YELLOW);
+    }
 
-        if (IsKeyDown(KEY_F3)) {
-            DrawFPS(50, 50);
-        }
+    EndDistanceFieldText();
+    EndProfilerPass();
 
-        EndDrawing();
+    if (renderState->showProfiler) {
+        DrawProfilerOverlay(50, 50);
     }
 
-    UnloadRenderTexture(targetTex);
-    UnloadTexture(targetTex.texture);
-    UnloadShader(sdfShader);
-    UnloadFont(openSansFont);
-    UnloadFont(vt323Font);
-
-    CloseWindow();
-    return 0;
+    FinishPacedFrame(&renderer->pacer);
+    EndDrawing();
+    PresentPacedFrame(&renderer->pacer, renderState->inputTime);
+    UpdateProfilerLatency(renderer->pacer.latency);
 }
 
 bool FileMissing(const char *path) {
@@ -462,48 +813,145 @@ bool EnsureResourcesExist(void) {
     return false;
 }
 
-static Shader LoadSDFShaderWithVersion(char* versionString) {
-    // Should this be freed?
-    char* rawShaderCode = LoadText(resourcePaths[RESOURCE_SHADER]);
+bool ReportMissingResources(void) {
+    bool missingFiles = false;
+    for (int i = 0; i < RESOURCE_COUNT; i++) {
+        if (FileMissing(resourcePaths[i])) {
+            printf("ERROR: Missing file: %s\n", resourcePaths[i]);
+            missingFiles = true;
+        }
+    }
+    return missingFiles;
+}
 
-    // Memory: Version string + \n + shader code + \0
-    int len = strlen(versionString) + 1 + strlen(rawShaderCode) + 1;
+int CheckGoldenViews(Renderer *renderer, const char *directory, bool update,
+                     float maxDistance) {
+    // The start, the tunnel, the curve and the station, each with the
+    // lights behind the camera, around it, and ahead of it
+    float distances[] = { 0.0f, 300.0f, 1000.0f, 2050.0f };
+    int stageOffsets[] = { -3, 0, 3 };
 
-    char* shaderCode = (char *)malloc(len);
-    snprintf(shaderCode, len, "%s\n%s", versionString, rawShaderCode);
-    Shader shader = LoadShaderCode(0, shaderCode);
+    // The references are rendered at full resolution, without foveation
+    if (renderer->renderScaleIndex != 0) {
+        UnloadRenderTexture(renderer->targetTex);
+        renderer->renderScaleIndex = 0;
+        renderer->targetTex = LoadSDFRenderTexture(&renderer->sdfShader,
+                                                   renderScales[0]);
+    }
+    SetSDFShaderFoveated(&renderer->sdfShader, false);
 
-    // The shader code memory can be freed after use, because LoadShaderCode
-    // just passes the code to glShaderSource, whose documentation
-    // explicitly states that the original memory can be freed,
-    // since it is copied.
-    free(shaderCode);
-    return shader;
+    // The game's lights go from stage 0 to the one at the end of the
+    // tunnel, so the middle stage is kept far enough from both ends for
+    // the offset ones to be states players can actually see
+    int lastStage = (int)((maxDistance - 9.0f) / 9.0f);
+    int failures = 0;
+    for (int i = 0; i < (int)(sizeof(distances) / sizeof(distances[0])); i++) {
+        float z = distances[i];
+        int stage = (int)(z / 9.0f);
+        if (stage < 3) {
+            stage = 3;
+        } else if (stage > lastStage - 3) {
+            stage = lastStage - 3;
+        }
+        Vector3 forward = GetPathForward((Vector3){ 0.0f, 0.0f, z },
+                                         maxDistance);
+        for (int j = 0; j < (int)(sizeof(stageOffsets) / sizeof(stageOffsets[0])); j++) {
+            GoldenView view = {
+                .position = { GetXOffset(z, maxDistance), 1.75f, z },
+                .rotation = { 0.0f, atan2f(forward.x, forward.z) * RAD2DEG, 0.0f },
+                .stage = stage + stageOffsets[j],
+            };
+            snprintf(view.name, sizeof(view.name), "z%d-stage%d",
+                     (int)z, view.stage);
+            if (!CheckGoldenView(&renderer->sdfShader, renderer->targetTex,
+                                 view, directory, update)) {
+                failures++;
+            }
+        }
+    }
+    SetSDFShaderFoveated(&renderer->sdfShader, renderer->foveatedRendering);
+    return failures;
 }
 
-Shader LoadSDFShader(void) {
-    int glVersion = rlGetVersion();
-    Shader shader;
-    if (glVersion == OPENGL_11) {
-        printf("ERROR: OpenGL 1.1 is not supported.\n");
-        shader = LoadShader(0, 0);
-    } else if (glVersion == OPENGL_33) {
-        shader = LoadSDFShaderWithVersion("#version 330");
-    } else if (glVersion == OPENGL_ES_20) {
-        shader = LoadSDFShaderWithVersion("#version 100 es");
-    } else {
-        shader = LoadSDFShaderWithVersion("#version 120");
+bool RenderSequence(Renderer *renderer, const char *output, int width,
+                    int height, int frameCount, float maxDistance) {
+    if (width <= 0 || height <= 0 || frameCount <= 0) {
+        printf("WARNING: Invalid sequence size: %dx%d, %d frames.\n",
+               width, height, frameCount);
+        return false;
+    }
+    SequenceWriter *writer = StartSequenceWriter(output);
+    if (writer == NULL) {
+        return false;
+    }
+
+    // The script is turned into keyframes in world space, looking
+    // along the tunnel
+    CameraKeyframe keyframes[SEQUENCE_KEYFRAMES_COUNT];
+    for (int i = 0; i < SEQUENCE_KEYFRAMES_COUNT; i++) {
+        const float *script = sequenceScript[i];
+        Vector3 position =
+            TransformFromMetroSpace((Vector3){ script[1], script[2], script[0] },
+                                    maxDistance);
+        Vector3 forward = GetPathForward(position, maxDistance);
+        CameraKeyframe keyframe = {
+            .position = { position.x, position.y, position.z },
+            .rotation = {
+                script[3], atan2f(forward.x, forward.z) * RAD2DEG + script[4], 0.0f
+            },
+        };
+        keyframes[i] = keyframe;
     }
-    return shader;
+
+    RenderTexture2D target = LoadRenderTexture(width, height);
+    SetSDFShaderResolution(&renderer->sdfShader, width, height);
+    SetSDFShaderFoveated(&renderer->sdfShader, false);
+    for (int i = 0; i < frameCount; i++) {
+        float t = frameCount > 1 ? (float)i / (frameCount - 1) : 0.0f;
+        CameraKeyframe camera = GetCameraSplinePoint(keyframes,
+                                                     SEQUENCE_KEYFRAMES_COUNT, t);
+        // The lights follow the camera like they do in the game
+        float lightMaxDistance = maxDistance - 9.0f;
+        float triggerPosition = Clamp(NoiseifyPosition(camera.position[2]),
+                                      0.0f, lightMaxDistance);
+        int lightsStage = (int)(triggerPosition / 9.0f);
+
+        SetSDFShaderCamera(&renderer->sdfShader, camera.position,
+                           camera.rotation, 80.0f, lightsStage);
+        DrawSDFShader(&renderer->sdfShader, target);
+        // Read back like in CheckGoldenView, no flipping needed
+        if (!WriteSequenceFrame(writer, GetTextureData(target.texture))) {
+            break;
+        }
+        if ((i + 1) % 100 == 0 || i + 1 == frameCount) {
+            printf("INFO: Rendered %d/%d frames.\n", i + 1, frameCount);
+        }
+    }
+    bool written = FinishSequenceWriter(writer);
+    UnloadRenderTexture(target);
+
+    SetSDFShaderResolution(&renderer->sdfShader,
+                           renderer->targetTex.texture.width,
+                           renderer->targetTex.texture.height);
+    SetSDFShaderFoveated(&renderer->sdfShader, renderer->foveatedRendering);
+    return written;
 }
 
-bool ShowEpilepsyWarning(FontSetting *fontSetting) {
+RenderTexture2D LoadSDFRenderTexture(SDFShader *sdfShader, float renderScale) {
+    int height = (int)(VIRTUAL_SCREEN_HEIGHT * renderScale + 0.5f);
+    RenderTexture2D targetTex = LoadRenderTexture(height * 2, height);
+    SetSDFShaderResolution(sdfShader, height * 2, height);
+    return targetTex;
+}
+
+bool ShowEpilepsyWarning(FontSetting *fontSetting, SDFShader *sdfShader) {
     float time = (float)GetTime();
     float showPromptTime = time + 1.0f;
     float showPromptFadeDuration = 0.3f;
     float acceptPromptTime = time + 0.5f;
+    bool shaderLoaded = false;
 
-    while (GetTime() < acceptPromptTime || IsKeyUp(KEY_SPACE)) {
+    while (GetTime() < acceptPromptTime || IsKeyUp(KEY_SPACE) || !shaderLoaded) {
         if (WindowShouldClose()) {
             return true;
         }
@@ -516,6 +964,7 @@ bool ShowEpilepsyWarning(FontSetting *fontSetting) {
         float x = (GetScreenWidth() - 640.0f) / 2.0f + 180.0f;
         float y = (GetScreenHeight() - 480.0f) / 2.0f + 400.0f;
 
+        BeginDistanceFieldText();
         if (time > showPromptTime) {
             float progress =
                 Clamp((time - showPromptTime) / showPromptFadeDuration, 0, 1);
@@ -544,11 +993,175 @@ bool ShowEpilepsyWarning(FontSetting *fontSetting) {
         DrawTextEx(fontSetting->clearFont,
                    "exit the experience by closing the window or pressing F4.",
                    (Vector2){ x, y }, 36, 0.0f, textColor);
+        EndDistanceFieldText();
         EndDrawing();
+
+        // Polled only after the warning is on screen, since drivers
+        // without parallel shader compilation support will block here
+        shaderLoaded = IsSDFShaderLoaded(sdfShader);
     }
     return false;
 }
 
+void StepGame(GameState *state, const GameInput *input, float bobbingIntensity,
+              float maxDistance, const NarrationScript *narration) {
+    float delta = SIMULATION_TIMESTEP;
+    float *cameraPosition = state->cameraPosition;
+    float *cameraRotation = state->cameraRotation;
+
+    // Turn around
+    cameraRotation[1] += delta * input->turnSpeedX;
+    if (cameraRotation[1] < 0.0) {
+        cameraRotation[1] += 360.0f;
+    } else if (cameraRotation[1] > 360) {
+        cameraRotation[1] -= 360.0f;
+    }
+    cameraRotation[0] = Clamp(cameraRotation[0] + delta * input->turnSpeedY,
+                              -90.0f, 90.0f);
+
+    // Run toggle
+    if (input->toggleRun) {
+        state->running = !state->running;
+    }
+
+    // Walk
+    float r = cameraRotation[1] * DEG2RAD;
+    bool walking = state->autoMove;
+    float speed = state->running ? RUN_SPEED : WALK_SPEED;
+    Vector3 movement = { 0.0f, 0.0f, 0.0f };
+    if (input->toggleAutoMove) {
+        state->autoMove = !state->autoMove;
+    }
+    if (state->autoMove) {
+        movement.x += delta * speed * sinf(r);
+        movement.z += delta * speed * cosf(r);
+    }
+    if (input->forward) {
+        movement.x += delta * speed * sinf(r);
+        movement.z += delta * speed * cosf(r);
+        walking = true;
+        state->autoMove = false;
+    }
+    if (input->backward) {
+        movement.x -= delta * speed * sinf(r);
+        movement.z -= delta * speed * cosf(r);
+        walking = true;
+        state->autoMove = false;
+    }
+    if (input->strafeRight) {
+        movement.x += delta * speed * cosf(r);
+        movement.z += delta * speed * -sinf(r);
+        walking = true;
+    }
+    if (input->strafeLeft) {
+        movement.x -= delta * speed * cosf(r);
+        movement.z -= delta * speed * -sinf(r);
+        walking = true;
+    }
+
+    // The actual movement
+    Vector3 position = { cameraPosition[0], 0.0f, cameraPosition[2] };
+    // ..on the forward axis
+    Vector3 forward = GetPathForward(position, maxDistance);
+    float forwardDotMovement = Vector3DotProduct(forward, movement);
+    forward = Vector3Scale(forward, forwardDotMovement);
+    position = GetLegalPlayerMovement(position, forward, maxDistance);
+    // ..on the right axis
+    Vector3 right = GetPathNormal(position, maxDistance);
+    right = Vector3Scale(right, Vector3DotProduct(right, movement));
+    position = GetLegalPlayerMovement(position, right, maxDistance);
+    // ..and finally applying it to the actual coordinates
+    float previousX = cameraPosition[0];
+    float previousZ = cameraPosition[2];
+    cameraPosition[0] = position.x;
+    cameraPosition[2] = Clamp(position.z, -10.0f, maxDistance + 10.0f);
+    float deltaX = cameraPosition[0] - previousX;
+    float deltaZ = cameraPosition[2] - previousZ;
+    state->metersWalked += sqrtf(deltaX * deltaX + deltaZ * deltaZ);
+    state->forwardDotMovement = forwardDotMovement;
+
+    if (walking) {
+        state->walkingTime += delta;
+    } else {
+        state->walkingTime = 0.0f;
+    }
+
+    // Crouch and bob
+    cameraPosition[1] -= state->headBobAmount;
+    float bobTime = state->walkingTime * 6.28f * HEAD_BOB_FREQUENCY *
+        (state->running ? 1.4f : 1.0f);
+    float targetBob = sinf(bobTime) * HEAD_BOB_MAGNITUDE * bobbingIntensity;
+    state->headBobAmount = Lerp(state->headBobAmount, targetBob,
+                                HEAD_BOB_SMOOTHING);
+    Vector3 cameraPositionVec = {
+        cameraPosition[0], cameraPosition[1], cameraPosition[2]
+    };
+    float relativeX = TransformToMetroSpace(cameraPositionVec, maxDistance).x;
+    bool onPlank = fabs(relativeX) < 1.0;
+    bool onRail = fabs(relativeX) > 0.762 - 0.05 &&
+        fabs(relativeX) < 0.762 + 0.05;
+    float height = onRail ? 0.3f : (onPlank ? 0.1f : 0.0f);
+    if (input->crouch) {
+        height += 0.9f;
+    } else {
+        height += 1.75f;
+    }
+    cameraPosition[1] = Lerp(cameraPosition[1], height, 10.0f * delta);
+    cameraPosition[1] += state->headBobAmount;
+
+    // Activate location-based actions
+    float lightMaxDistance = maxDistance - 9.0f;
+    float triggerPosition = Clamp(NoiseifyPosition(cameraPosition[2]),
+                                  0.0f, lightMaxDistance);
+    if (triggerPosition > (state->lightsStage + 1) * 9) {
+        state->lightsStage++;
+    }
+    // The stages are spaced out by the script, and there's nothing to
+    // advance to past its last stage
+    if (state->narrationStage + 1 < narration->stageCount) {
+        float nextStageStart =
+            GetNarrationStageStart(narration, state->narrationStage + 1);
+        if (cameraPosition[2] > nextStageStart) {
+            state->narrationStartZ = nextStageStart;
+            state->narrationStage++;
+        }
+    }
+
+    // Backtracking check
+    state->backtracking = false;
+    if (cameraPosition[2] > state->furthestDistanceSoFar) {
+        state->furthestDistanceSoFar = cameraPosition[2];
+        state->backtrackingTime = 0.0f;
+    } else if (state->furthestDistanceSoFar - cameraPosition[2] > BACKTRACKING_WARNING_DISTANCE) {
+        state->backtracking = true;
+        state->backtrackingTime += delta;
+    }
+}
+
+// Blends the continuous values, the discrete ones (like the progress
+// values) are taken from the current state.
+GameState InterpolateGameState(const GameState *previous,
+                               const GameState *current, float alpha) {
+    GameState state = *current;
+    for (int i = 0; i < 3; i++) {
+        state.cameraPosition[i] = Lerp(previous->cameraPosition[i],
+                                       current->cameraPosition[i], alpha);
+    }
+    state.cameraRotation[0] = Lerp(previous->cameraRotation[0],
+                                   current->cameraRotation[0], alpha);
+    // The yaw wraps around at 360, so take the shorter way around
+    float yawDelta = current->cameraRotation[1] - previous->cameraRotation[1];
+    if (yawDelta > 180.0f) {
+        yawDelta -= 360.0f;
+    } else if (yawDelta < -180.0f) {
+        yawDelta += 360.0f;
+    }
+    state.cameraRotation[1] = previous->cameraRotation[1] + yawDelta * alpha;
+    state.metersWalked = Lerp(previous->metersWalked, current->metersWalked,
+                              alpha);
+    return state;
+}
+
 Vector3 GetLegalPlayerMovement(Vector3 position, Vector3 movement, float maxDistance) {
     Vector3d newPos = Vector3dAdd(FromVector3(position), FromVector3(movement));
     Vector3d transformedPos = TransformToMetroSpaceD(newPos, maxDistance);
@@ -562,28 +1175,41 @@ float NoiseifyPosition(float position) {
     return position + (int)(position * 4.1) % 14 - 7;
 }
 
-void DisplaySubtitle(Font font, const char *subtitle, float fontSize, float y) {
-    Vector2 size = MeasureTextEx(font, subtitle, fontSize, 0.0f);
-    Vector2 position = { (GetScreenWidth() - (size.x - fontSize)) / 2.0f, y };
-    DrawTextEx(font, subtitle, position, fontSize, 0.0f, YELLOW);
+void UpdateSubtitleLayouts(SubtitleLayouts *subtitles,
+                           const NarrationScript *narration, Font font,
+                           float fontSize) {
+    if (subtitles->textureId == font.texture.id &&
+        subtitles->fontSize == fontSize) {
+        return;
+    }
+    UnloadSubtitleLayouts(subtitles);
+    subtitles->textureId = font.texture.id;
+    subtitles->fontSize = fontSize;
+    subtitles->lineCount = narration->stageCount * narration->linesPerStage;
+    subtitles->lines = malloc(subtitles->lineCount * sizeof(TextLayout));
+    if (subtitles->lines == NULL) {
+        subtitles->lineCount = 0;
+    }
+    for (int i = 0; i < subtitles->lineCount; i++) {
+        subtitles->lines[i] =
+            LayoutText(font, narration->lines[i], fontSize, 0.0f);
+    }
+    subtitles->backtrackingWarning =
+        LayoutText(font, "Warning: You're going the wrong way.", fontSize,
+                   0.0f);
 }
 
-int GetLine(float narrationTime, int narrationStage, int linesPerScreen) {
-    float timeCounter = 0.0f;
-    const char **lines = narratorComments[narrationStage];
-    int lineIndex = 0;
-    for (; lineIndex < COMMENT_LINES; lineIndex += linesPerScreen) {
-        for (int j = 0; j < linesPerScreen; j++) {
-            const char *line = lines[lineIndex + j];
-            timeCounter += (float)strlen(line) * METERS_PER_CHARACTER;
-        }
-        if (narrationTime < timeCounter) {
-            if (narrationTime > timeCounter - METERS_PER_CHARACTER * 2.0f) {
-                // Leave gaps between lines
-                return -1;
-            }
-            break;
-        }
+void UnloadSubtitleLayouts(SubtitleLayouts *subtitles) {
+    for (int i = 0; i < subtitles->lineCount; i++) {
+        UnloadTextLayout(subtitles->lines[i]);
     }
-    return lineIndex;
+    free(subtitles->lines);
+    UnloadTextLayout(subtitles->backtrackingWarning);
+    *subtitles = (SubtitleLayouts){ 0 };
+}
+
+void DisplaySubtitle(TextLayout subtitle, float fontSize, float y) {
+    Vector2 size = subtitle.size;
+    Vector2 position = { (GetScreenWidth() - (size.x - fontSize)) / 2.0f, y };
+    DrawTextLayout(subtitle, position, YELLOW);
 }
@@ -21,6 +21,7 @@
 #include "font_setting.h"
 #include "raymath.h"
 #include "render_utils.h"
+#include "text_layout.h"
 
 // These are the font and row height values used when no scaling is applied
 #define BASE_OPTION_FONT_SIZE 26.0f
@@ -34,6 +35,15 @@ static int uiScale = 1;
 static Color textColor = { 0xEE, 0xEE, 0xEE, 0xFF };
 static Color sliderColor = { 0x55, 0x50, 0x40, 0xFF };
 
+// The labels are the same from frame to frame, so they're laid out once
+static TextLayoutCache menuTextLayouts = { 0 };
+
+static
+TextLayout GetMenuTextLayout(FontSetting *fontSetting, const char *text) {
+    return GetCachedTextLayout(&menuTextLayouts, *fontSetting->currentFont,
+                               text, optionFontSize, 0.0f);
+}
+
 static
 bool IsNextSelected(void) {
     bool shifted = IsKeyDown(KEY_LEFT_SHIFT) ||
@@ -88,8 +98,8 @@ bool Button(FontSetting *fontSetting, const char* text, Rectangle button,
             clicked = true;
         }
     }
-    DrawTextEx(*fontSetting->currentFont, text,
-               textPosition, optionFontSize, 0.0f, textColor);
+    DrawTextLayout(GetMenuTextLayout(fontSetting, text), textPosition,
+                   textColor);
     return clicked;
 }
 
@@ -132,14 +142,13 @@ void Slider(FontSetting *fontSetting, float deltaTime,
     }
 
     // Draw text
-    DrawTextEx(*fontSetting->currentFont, text,
-               textPosition, optionFontSize, 0.0f, textColor);
-    Vector2 size = MeasureTextEx(*fontSetting->currentFont, text, optionFontSize, 0.0f);
-    textPosition.x += size.x;
+    TextLayout label = GetMenuTextLayout(fontSetting, text);
+    DrawTextLayout(label, textPosition, textColor);
+    textPosition.x += label.size.x;
     char valueDisplay[16];
     snprintf(valueDisplay, 16, formattingString, *value);
-    DrawTextEx(*fontSetting->currentFont, valueDisplay,
-               textPosition, optionFontSize, 0.0f, textColor);
+    DrawTextLayout(GetMenuTextLayout(fontSetting, valueDisplay), textPosition,
+                   textColor);
 
     if (pressedSlider == text) {
         if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
@@ -213,10 +222,67 @@ int GetUIScale(void) {
 
 static bool optionsOpened = false;
 
-bool ShowMainMenu(FontSetting *fontSetting, Texture2D gameRenderTexture,
-                  bool gameStarted, float *fov, float *bobIntensity,
-                  int *mouseSpeedX, int *mouseSpeedY, bool *showMetersWalked,
-                  bool *narrationEnabled) {
+// The game view, the fade and the header only change on resize, font
+// switches and during the fade-in, so they're drawn into a texture
+// then, and the texture is drawn under the widgets every frame.
+typedef struct {
+    RenderTexture2D texture;
+    Font *font;
+    int filterAlpha;
+} MenuBackground;
+
+static Color backgroundColor = { 0x33, 0x33, 0x33, 0xFF };
+
+static
+void UpdateMenuBackground(MenuBackground *background, FontSetting *fontSetting,
+                          Texture2D gameRenderTexture, int filterAlpha,
+                          Vector2 headerPosition) {
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    bool resized = background->texture.texture.width != width ||
+        background->texture.texture.height != height;
+    if (!resized && background->font == fontSetting->currentFont &&
+        background->filterAlpha == filterAlpha) {
+        return;
+    }
+
+    if (resized) {
+        if (background->texture.id != 0) {
+            UnloadRenderTexture(background->texture);
+        }
+        background->texture = LoadRenderTexture(width, height);
+    }
+    background->font = fontSetting->currentFont;
+    background->filterAlpha = filterAlpha;
+
+    BeginTextureMode(background->texture);
+    ClearBackground(backgroundColor);
+    EndTextureMode();
+
+    // Draw game
+    DrawGameViewToTexture(gameRenderTexture, background->texture);
+
+    BeginTextureMode(background->texture);
+    // Draw filter to fade it out a bit
+    DrawRectangle(0, 0, width, height, (Color){0x20, 0x24, 0x30, filterAlpha});
+    // Draw the header
+    BeginDistanceFieldText();
+    DrawTextEx(*fontSetting->currentFont, "A Walk In A Metro Tunnel",
+               headerPosition, optionFontSize * 1.5f, 0.0f, textColor);
+    EndDistanceFieldText();
+    // Blending lowered the alpha under the filter and the text, this
+    // raises it back to opaque without touching the colors
+    BeginBlendMode(BLEND_ADDITIVE);
+    DrawRectangle(0, 0, width, height, BLACK);
+    EndBlendMode();
+    EndTextureMode();
+}
+
+static
+bool RunMainMenu(MenuBackground *background, FontSetting *fontSetting,
+                 Texture2D gameRenderTexture, bool gameStarted, float *fov,
+                 float *bobIntensity, int *mouseSpeedX, int *mouseSpeedY,
+                 bool *showMetersWalked, bool *narrationEnabled) {
     bool continueGame = false;
     int selectionIndex = -1;
     float lastTime = (float)GetTime();
@@ -260,32 +326,34 @@ bool ShowMainMenu(FontSetting *fontSetting, Texture2D gameRenderTexture,
 
         selectionIndex = GetNewSelectionIndex(selectionIndex, optionsOpened);
 
-        BeginDrawing();
-        ClearBackground((Color){ 0x33, 0x33, 0x33, 0xFF });
-
         float controlX = 50.0f + screenSizeOffsetX;
         float controlY = 40.0f + screenSizeOffsetY;
 
-        // Draw game
-        DrawGameView(gameRenderTexture);
-        // Draw filter to fade it out a bit
         int filterAlpha;
+        float filterAnimTime = 0.2f;
+        bool fading = gameStarted && time - startTime < filterAnimTime;
         if (gameStarted) {
-            float filterAnimTime = 0.2f;
             filterAlpha = (char)(Clamp((time - startTime) / filterAnimTime,
                                        0, 1) * 0xBB);
         } else {
             filterAlpha = 0xBB;
         }
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(),
-                      (Color){0x20, 0x24, 0x30, filterAlpha});
+        UpdateMenuBackground(background, fontSetting, gameRenderTexture,
+                             filterAlpha, (Vector2){ controlX, controlY });
 
-        // Draw the header
-        DrawTextEx(*fontSetting->currentFont, "A Walk In A Metro Tunnel",
-                   (Vector2) { controlX, controlY },
-                   optionFontSize * 1.5f, 0.0f, textColor);
-
-        // Start drawing the menu
+        BeginDrawing();
+        ClearBackground(backgroundColor);
+
+        // Draw the game, the filter and the header
+        Texture2D backgroundTexture = background->texture.texture;
+        DrawTextureRec(backgroundTexture,
+                       (Rectangle){ 0.0f, 0.0f, (float)backgroundTexture.width,
+                               -(float)backgroundTexture.height },
+                       (Vector2){ 0.0f, 0.0f }, WHITE);
+
+        // Start drawing the menu, all in one distance field text pass so
+        // the widgets' labels don't flush the batch one by one
+        BeginDistanceFieldText();
         controlX -= 10.0f;
         controlY += 90.0f * uiScale;
         Rectangle startButton = { controlX, controlY,
@@ -313,6 +381,7 @@ bool ShowMainMenu(FontSetting *fontSetting, Texture2D gameRenderTexture,
                            controlY + 3.5f * uiScale },
                    redButtonColor, redButtonHighlightColor,
                    selectionIndex == (optionsOpened ? 1 : 2))) {
+            EndDistanceFieldText();
             return true;
         }
         if (optionsOpened) {
@@ -485,7 +554,36 @@ bool ShowMainMenu(FontSetting *fontSetting, Texture2D gameRenderTexture,
             }
         }
 
+        // Nothing changes without input when the fade is done and no
+        // slider is being moved with the keyboard, so the menu can just
+        // wait for events instead of drawing the same frame over again
+        bool keyHeld = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A) ||
+            IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+        if (fading || keyHeld || continueGame) {
+            DisableEventWaiting();
+        } else {
+            EnableEventWaiting();
+        }
+
+        EndDistanceFieldText();
         EndDrawing();
     }
     return false;
 }
+
+bool ShowMainMenu(FontSetting *fontSetting, Texture2D gameRenderTexture,
+                  bool gameStarted, float *fov, float *bobIntensity,
+                  int *mouseSpeedX, int *mouseSpeedY, bool *showMetersWalked,
+                  bool *narrationEnabled) {
+    MenuBackground background = { 0 };
+    bool closeApplication = RunMainMenu(&background, fontSetting,
+                                        gameRenderTexture, gameStarted, fov,
+                                        bobIntensity, mouseSpeedX, mouseSpeedY,
+                                        showMetersWalked, narrationEnabled);
+    DisableEventWaiting();
+    if (background.texture.id != 0) {
+        UnloadRenderTexture(background.texture);
+    }
+    ClearTextLayoutCache(&menuTextLayouts);
+    return closeApplication;
+}
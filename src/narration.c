@@ -0,0 +1,198 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "narration.h"
+#include "little_endian.h"
+
+// The file starts with these, followed by the stage and line counts, the
+// stage start and length, the line gap, the end distance and length of
+// every line, and finally the lines, each followed by a null, so they
+// can be used straight from the loaded file. All values are
+// little-endian, like in input logs.
+#define NARRATION_MAGIC "MTNS"
+#define NARRATION_VERSION 2
+#define NARRATION_HEADER_SIZE (5 + 5 * 4)
+
+bool SaveNarrationScript(const char *path, const char **lines,
+                         int stageCount, int linesPerStage,
+                         float stageStart, float stageLength,
+                         float metersPerCharacter, float lineGap) {
+    int lineCount = stageCount * linesPerStage;
+    size_t length = NARRATION_HEADER_SIZE + lineCount * 8;
+    for (int i = 0; i < lineCount; i++) {
+        length += strlen(lines[i]) + 1;
+    }
+    unsigned char *data = malloc(length);
+    if (data == NULL) {
+        return false;
+    }
+
+    memcpy(data, NARRATION_MAGIC, 4);
+    data[4] = NARRATION_VERSION;
+    unsigned char *cursor = data + 5;
+    cursor = PutU32(cursor, stageCount);
+    cursor = PutU32(cursor, linesPerStage);
+    cursor = PutF32(cursor, stageStart);
+    cursor = PutF32(cursor, stageLength);
+    cursor = PutF32(cursor, lineGap);
+    for (int stage = 0; stage < stageCount; stage++) {
+        float end = 0.0f;
+        for (int i = 0; i < linesPerStage; i++) {
+            const char *line = lines[stage * linesPerStage + i];
+            end += (float)strlen(line) * metersPerCharacter;
+            cursor = PutF32(cursor, end);
+        }
+    }
+    for (int i = 0; i < lineCount; i++) {
+        cursor = PutU32(cursor, (unsigned int)strlen(lines[i]));
+    }
+    for (int i = 0; i < lineCount; i++) {
+        size_t lineLength = strlen(lines[i]) + 1;
+        memcpy(cursor, lines[i], lineLength);
+        cursor += lineLength;
+    }
+
+    FILE *file = fopen(path, "wb");
+    bool written = file != NULL && fwrite(data, 1, length, file) == length;
+    if (file != NULL) {
+        written &= fclose(file) == 0;
+    }
+    if (!written) {
+        printf("WARNING: Could not write the narration script '%s'.\n", path);
+    }
+    free(data);
+    return written;
+}
+
+NarrationScript LoadNarrationScript(const char *path) {
+    NarrationScript script = { 0 };
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("WARNING: Could not open the narration script '%s'.\n", path);
+        return script;
+    }
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        length = ftell(file);
+    }
+    unsigned char *data = NULL;
+    if (length >= NARRATION_HEADER_SIZE && fseek(file, 0, SEEK_SET) == 0) {
+        data = malloc(length);
+        if (data != NULL && fread(data, 1, length, file) != (size_t)length) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(file);
+
+    unsigned int stageCount = 0, linesPerStage = 0;
+    bool valid = data != NULL && memcmp(data, NARRATION_MAGIC, 4) == 0 &&
+        data[4] == NARRATION_VERSION;
+    const unsigned char *cursor = NULL;
+    if (valid) {
+        cursor = GetU32(data + 5, &stageCount);
+        cursor = GetU32(cursor, &linesPerStage);
+        cursor = GetF32(cursor, &script.stageStart);
+        cursor = GetF32(cursor, &script.stageLength);
+        cursor = GetF32(cursor, &script.lineGap);
+        valid = stageCount < 1024 && linesPerStage < 1024 &&
+            script.stageLength > 0.0f &&
+            (size_t)length >= NARRATION_HEADER_SIZE +
+            (size_t)stageCount * linesPerStage * 8;
+    }
+    int lineCount = (int)(stageCount * linesPerStage);
+    if (valid) {
+        script.lines = malloc(lineCount * sizeof(const char *));
+        script.lineEnds = malloc(lineCount * sizeof(float));
+        valid = script.lines != NULL && script.lineEnds != NULL;
+    }
+    if (valid) {
+        for (int i = 0; i < lineCount; i++) {
+            cursor = GetF32(cursor, &script.lineEnds[i]);
+        }
+        // The lines follow the lengths, check that each one fits in the
+        // file and ends where it should
+        const unsigned char *text = cursor + lineCount * 4;
+        const unsigned char *end = data + length;
+        for (int i = 0; valid && i < lineCount; i++) {
+            unsigned int lineLength;
+            cursor = GetU32(cursor, &lineLength);
+            valid = (size_t)(end - text) > lineLength &&
+                text[lineLength] == '\0';
+            script.lines[i] = (const char *)text;
+            text += lineLength + 1;
+        }
+    }
+    if (!valid) {
+        printf("WARNING: '%s' is not a supported narration script.\n", path);
+        free(script.lines);
+        free(script.lineEnds);
+        free(data);
+        return (NarrationScript){ 0 };
+    }
+
+    script.stageCount = (int)stageCount;
+    script.linesPerStage = (int)linesPerStage;
+    script.data = data;
+    return script;
+}
+
+void UnloadNarrationScript(NarrationScript *script) {
+    free(script->lines);
+    free(script->lineEnds);
+    free(script->data);
+    *script = (NarrationScript){ 0 };
+}
+
+int GetNarrationLine(const NarrationScript *script, int stage,
+                     float distance, int linesPerScreen) {
+    if (stage < 0 || stage >= script->stageCount) {
+        return -1;
+    }
+    // The screens end where their last lines do, and those distances only
+    // grow, so the first screen that ends after the distance is found by
+    // a binary search
+    const float *lineEnds = &script->lineEnds[stage * script->linesPerStage];
+    int screenCount = script->linesPerStage / linesPerScreen;
+    int first = 0;
+    int last = screenCount;
+    while (first < last) {
+        int middle = (first + last) / 2;
+        if (lineEnds[(middle + 1) * linesPerScreen - 1] > distance) {
+            last = middle;
+        } else {
+            first = middle + 1;
+        }
+    }
+    if (first == screenCount) {
+        return script->linesPerStage;
+    }
+    float screenEnd = lineEnds[(first + 1) * linesPerScreen - 1];
+    if (distance > screenEnd - script->lineGap) {
+        // Leave gaps between lines
+        return -1;
+    }
+    return first * linesPerScreen;
+}
+
+float GetNarrationStageStart(const NarrationScript *script, int stage) {
+    return script->stageStart + stage * script->stageLength;
+}
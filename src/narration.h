@@ -0,0 +1,64 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef NARRATION_H
+#define NARRATION_H
+
+#include <stdbool.h>
+
+// The narration script is compiled from script.h into a binary asset
+// (by tools/compile_script.c, run by the build scripts), which has the
+// lines, where each stage starts and the distance at which each line
+// ends, so the game reads it once at startup and finds the lines to show
+// with a binary search.
+
+typedef struct {
+    int stageCount;
+    int linesPerStage;
+    // Stage i starts at stageStart + i * stageLength along the tunnel
+    float stageStart;
+    float stageLength;
+    // How long before the end of a screen of lines it's hidden, to leave
+    // gaps between the screens
+    float lineGap;
+    // stageCount * linesPerStage lines, stage by stage
+    const char **lines;
+    // The distance from the start of the stage at which each line ends,
+    // counting the lines before it in the same stage
+    float *lineEnds;
+    unsigned char *data;
+} NarrationScript;
+
+// Writes the compiled script asset, where the lines are shown for
+// metersPerCharacter per character. The lines are given stage by stage.
+bool SaveNarrationScript(const char *path, const char **lines,
+                         int stageCount, int linesPerStage,
+                         float stageStart, float stageLength,
+                         float metersPerCharacter, float lineGap);
+// The script is empty (no stages) if it couldn't be loaded.
+NarrationScript LoadNarrationScript(const char *path);
+void UnloadNarrationScript(NarrationScript *script);
+
+// Returns the first line of the screen of lines shown at the distance
+// from the start of the stage, -1 between screens, or linesPerStage
+// after the last one.
+int GetNarrationLine(const NarrationScript *script, int stage,
+                     float distance, int linesPerScreen);
+// Returns where the stage starts along the tunnel.
+float GetNarrationStageStart(const NarrationScript *script, int stage);
+
+#endif
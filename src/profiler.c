@@ -0,0 +1,116 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "profiler.h"
+#include "rlgl.h"
+
+// How much of the previous average is kept each frame, so the overlay
+// is actually readable
+#define PROFILER_SMOOTHING 0.95f
+
+static const char *passNames[PROFILER_PASS_COUNT] = {
+    "Ray marching", "Game view", "Text and UI"
+};
+
+static float passTimes[PROFILER_PASS_COUNT] = { 0.0f };
+static float frameTime = 0.0f;
+// Input-to-present latency in milliseconds, negative when not measured
+static float latency = -1.0f;
+// GL calls issued and skipped by rlgl's state cache during the last frame
+static unsigned int glCalls = 0;
+static unsigned int glCallsSkipped = 0;
+static unsigned int glCallsTotal = 0;
+static unsigned int glCallsSkippedTotal = 0;
+
+void BeginProfilerPass(ProfilerPass pass) {
+    rlBeginTimerQuery(pass);
+}
+
+void EndProfilerPass(void) {
+    rlEndTimerQuery();
+}
+
+void UpdateProfiler(void) {
+    rlUpdateTimerQueries();
+    for (int i = 0; i < PROFILER_PASS_COUNT; i++) {
+        float time = (float)rlGetTimerQueryTime(i);
+        passTimes[i] = passTimes[i] * PROFILER_SMOOTHING +
+            time * (1.0f - PROFILER_SMOOTHING);
+    }
+    frameTime = frameTime * PROFILER_SMOOTHING +
+        GetFrameTime() * 1000.0f * (1.0f - PROFILER_SMOOTHING);
+
+    // The rlgl counters are totals, so the frame's calls are the difference
+    unsigned int total = rlGetGLCallsCount();
+    unsigned int skippedTotal = rlGetGLCallsSkipped();
+    glCalls = total - glCallsTotal;
+    glCallsSkipped = skippedTotal - glCallsSkippedTotal;
+    glCallsTotal = total;
+    glCallsSkippedTotal = skippedTotal;
+}
+
+float GetProfilerPassTime(ProfilerPass pass) {
+    return passTimes[pass];
+}
+
+void UpdateProfilerLatency(float newLatency) {
+    if (newLatency < 0.0f || latency < 0.0f) {
+        latency = newLatency;
+    } else {
+        latency = latency * PROFILER_SMOOTHING +
+            newLatency * (1.0f - PROFILER_SMOOTHING);
+    }
+}
+
+void DrawProfilerOverlay(int x, int y) {
+    int fontSize = 20;
+    int lineHeight = fontSize + 4;
+    int lines = 3 + PROFILER_PASS_COUNT + (latency >= 0.0f ? 1 : 0);
+    DrawRectangle(x - 10, y - 10, 330, lines * lineHeight + 16,
+                  (Color){ 0x00, 0x00, 0x00, 0xAA });
+
+    DrawText(TextFormat("%2i FPS, frame: %6.2f ms", GetFPS(), frameTime),
+             x, y, fontSize, LIME);
+    y += lineHeight;
+
+    // The default font isn't monospaced, so the values get their own column
+    int valueX = x + 200;
+    if (latency >= 0.0f) {
+        DrawText("Input latency", x, y, fontSize, LIME);
+        DrawText(TextFormat("%6.2f ms", latency), valueX, y, fontSize, LIME);
+        y += lineHeight;
+    }
+
+    DrawText("GL calls/skipped", x, y, fontSize, LIME);
+    DrawText(TextFormat("%4u / %u", glCalls, glCallsSkipped), valueX, y, fontSize, LIME);
+    y += lineHeight;
+
+    if (!rlTimerQuerySupported()) {
+        DrawText("GPU timers not supported", x, y, fontSize, LIME);
+        return;
+    }
+
+    float totalTime = 0.0f;
+    for (int i = 0; i < PROFILER_PASS_COUNT; i++) {
+        DrawText(passNames[i], x, y, fontSize, LIME);
+        DrawText(TextFormat("%6.2f ms", passTimes[i]), valueX, y, fontSize, LIME);
+        totalTime += passTimes[i];
+        y += lineHeight;
+    }
+    DrawText("GPU total", x, y, fontSize, LIME);
+    DrawText(TextFormat("%6.2f ms", totalTime), valueX, y, fontSize, LIME);
+}
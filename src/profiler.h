@@ -0,0 +1,35 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "raylib.h"
+
+typedef enum {
+    PROFILER_PASS_SDF, PROFILER_PASS_GAME_VIEW, PROFILER_PASS_UI,
+    PROFILER_PASS_COUNT
+} ProfilerPass;
+
+void BeginProfilerPass(ProfilerPass pass);
+void EndProfilerPass(void);
+void UpdateProfiler(void);
+float GetProfilerPassTime(ProfilerPass pass);
+void UpdateProfilerLatency(float latency);
+void DrawProfilerOverlay(int x, int y);
+
+#endif
@@ -15,19 +15,31 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "render_utils.h"
+#include "rlgl.h"
+
+static bool upscalingLoaded = false;
+static Shader easuShader;
+static Shader rcasShader;
+static int easuSourceSizeLocation;
+static RenderTexture2D upscaleTex;
 
-static Rectangle GetRenderSrc(int screenWidth, int screenHeight) {
+static Rectangle GetRenderSrc(int screenWidth, int screenHeight,
+                              float textureHeight) {
     float ratio = (float)screenWidth / (float)screenHeight;
     float margin, width, height;
     if (ratio < 2.0) {
-        margin = (VIRTUAL_SCREEN_HEIGHT * (2.0f - ratio)) / 2.0f;
-        width = VIRTUAL_SCREEN_HEIGHT * ratio;
-        height = (float)VIRTUAL_SCREEN_HEIGHT;
+        margin = (textureHeight * (2.0f - ratio)) / 2.0f;
+        width = textureHeight * ratio;
+        height = textureHeight;
     } else {
         margin = 0.0f;
-        width = VIRTUAL_SCREEN_HEIGHT * 2.0f;
-        height = (float)VIRTUAL_SCREEN_HEIGHT;
+        width = textureHeight * 2.0f;
+        height = textureHeight;
     }
     return (Rectangle){margin, 0.0f, width, height};
 }
@@ -47,11 +59,153 @@ static Rectangle GetRenderDest(int screenWidth, int screenHeight) {
     return (Rectangle){margin, 0.0f, width, height};
 }
 
-void DrawGameView(Texture2D texture) {
+static Shader LoadShaderWithVersion(const char *path,
+                                    Shader (*loadShaderCode)(char *, char *)) {
+    const char *versionString;
+    int glVersion = rlGetVersion();
+    if (glVersion == OPENGL_33) {
+        versionString = "#version 330";
+    } else if (glVersion == OPENGL_ES_20) {
+        versionString = "#version 100 es";
+    } else {
+        versionString = "#version 120";
+    }
+
+    char *rawShaderCode = LoadText(path);
+    if (rawShaderCode == NULL) {
+        // Without any code, this just returns the default shader
+        return loadShaderCode(0, 0);
+    }
+
+    // Memory: Version string + \n + shader code + \0
+    int len = strlen(versionString) + 1 + strlen(rawShaderCode) + 1;
+
+    char *shaderCode = (char *)malloc(len);
+    snprintf(shaderCode, len, "%s\n%s", versionString, rawShaderCode);
+    Shader shader = loadShaderCode(0, shaderCode);
+
+    // The shader code memory can be freed after use, because LoadShaderCode
+    // just passes the code to glShaderSource, whose documentation
+    // explicitly states that the original memory can be freed,
+    // since it is copied.
+    free(shaderCode);
+    free(rawShaderCode);
+    return shader;
+}
+
+Shader LoadVersionedShader(const char *fragmentShaderPath) {
+    return LoadShaderWithVersion(fragmentShaderPath, LoadShaderCode);
+}
+
+// The returned shader can't be used before it's passed through
+// FinishShaderLoading, but the driver can compile it in the meantime.
+Shader LoadVersionedShaderAsync(const char *fragmentShaderPath) {
+    return LoadShaderWithVersion(fragmentShaderPath, LoadShaderCodeAsync);
+}
+
+void LoadUpscalingShaders(const char *easuShaderPath, const char *rcasShaderPath) {
+    // Without shaders, the game view is just blitted with point
+    // filtering at whatever resolution it was rendered at
+    if (rlGetVersion() == OPENGL_11) {
+        return;
+    }
+
+    // LoadShaderCode falls back to the default shader on errors, and
+    // that one shouldn't be unloaded
+    unsigned int defaultShaderId = GetShaderDefault().id;
+    easuShader = LoadVersionedShader(easuShaderPath);
+    rcasShader = LoadVersionedShader(rcasShaderPath);
+    if (easuShader.id == defaultShaderId || rcasShader.id == defaultShaderId) {
+        printf("WARNING: Upscaling shaders could not be loaded.\n");
+        if (easuShader.id != defaultShaderId) {
+            UnloadShader(easuShader);
+        }
+        if (rcasShader.id != defaultShaderId) {
+            UnloadShader(rcasShader);
+        }
+        return;
+    }
+
+    // The scene is always reconstructed to the full virtual
+    // resolution, and then blitted to the screen as usual
+    upscaleTex = LoadRenderTexture(VIRTUAL_SCREEN_HEIGHT * 2,
+                                   VIRTUAL_SCREEN_HEIGHT);
+    easuSourceSizeLocation = GetShaderLocation(easuShader, "sourceSize");
+    int rcasSourceSizeLocation = GetShaderLocation(rcasShader, "sourceSize");
+    float upscaleSize[] = { (float)VIRTUAL_SCREEN_HEIGHT * 2,
+                            (float)VIRTUAL_SCREEN_HEIGHT };
+    SetShaderValue(rcasShader, rcasSourceSizeLocation, upscaleSize, UNIFORM_VEC2);
+    upscalingLoaded = true;
+}
+
+void UnloadUpscalingShaders(void) {
+    if (upscalingLoaded) {
+        UnloadRenderTexture(upscaleTex);
+        UnloadShader(easuShader);
+        UnloadShader(rcasShader);
+        upscalingLoaded = false;
+    }
+}
+
+// Full resolution renders keep the plain point filtered look
+static bool IsUpscaled(Texture2D texture) {
+    return upscalingLoaded && texture.height < VIRTUAL_SCREEN_HEIGHT;
+}
+
+// Reconstructs the virtual resolution frame from a smaller render. This
+// has to happen outside of other texture modes, since it uses its own.
+static void UpscaleGameView(Texture2D texture) {
+    float sourceSize[] = { (float)texture.width, (float)texture.height };
+    SetShaderValue(easuShader, easuSourceSizeLocation, sourceSize, UNIFORM_VEC2);
+    BeginTextureMode(upscaleTex);
+    BeginShaderMode(easuShader);
+    DrawTexturePro(texture,
+                   (Rectangle){ 0.0f, 0.0f, sourceSize[0], sourceSize[1] },
+                   (Rectangle){ 0.0f, 0.0f, (float)upscaleTex.texture.width,
+                           (float)upscaleTex.texture.height },
+                   (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndShaderMode();
+    EndTextureMode();
+}
+
+static void BlitGameView(Texture2D texture) {
     int screenWidth = GetScreenWidth();
     int screenHeight = GetScreenHeight();
-    DrawTexturePro(texture,
-                   GetRenderSrc(screenWidth, screenHeight),
-                   GetRenderDest(screenWidth, screenHeight),
+    Rectangle dest = GetRenderDest(screenWidth, screenHeight);
+
+    if (!IsUpscaled(texture)) {
+        DrawTexturePro(texture,
+                       GetRenderSrc(screenWidth, screenHeight,
+                                    (float)texture.height),
+                       dest, (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+        return;
+    }
+
+    // The upscaled frame is sharpened while blitting it to the screen.
+    // The source rectangle is flipped, because unlike the SDF shader,
+    // the upscaling pass doesn't flip its output.
+    Rectangle src = GetRenderSrc(screenWidth, screenHeight,
+                                 (float)VIRTUAL_SCREEN_HEIGHT);
+    src.height = -src.height;
+    BeginShaderMode(rcasShader);
+    DrawTexturePro(upscaleTex.texture, src, dest,
                    (Vector2){ 0.0f, 0.0f }, 0.0f, WHITE);
+    EndShaderMode();
+}
+
+void DrawGameView(Texture2D texture) {
+    if (IsUpscaled(texture)) {
+        UpscaleGameView(texture);
+    }
+    BlitGameView(texture);
+}
+
+// Like DrawGameView, but into a screen-sized render texture.
+void DrawGameViewToTexture(Texture2D texture, RenderTexture2D target) {
+    if (IsUpscaled(texture)) {
+        UpscaleGameView(texture);
+    }
+    BeginTextureMode(target);
+    BlitGameView(texture);
+    EndTextureMode();
 }
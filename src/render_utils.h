@@ -22,6 +22,11 @@
 
 #include "raylib.h"
 
+Shader LoadVersionedShader(const char *fragmentShaderPath);
+Shader LoadVersionedShaderAsync(const char *fragmentShaderPath);
+void LoadUpscalingShaders(const char *easuShaderPath, const char *rcasShaderPath);
+void UnloadUpscalingShaders(void);
 void DrawGameView(Texture2D texture);
+void DrawGameViewToTexture(Texture2D texture, RenderTexture2D target);
 
 #endif
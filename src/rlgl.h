@@ -32,6 +32,10 @@
 *   #define SUPPORT_VR_SIMULATOR
 *       Support VR simulation functionality (stereo rendering)
 *
+*   #define SUPPORT_INTERLEAVED_BATCH
+*       Store the default batch vertices interleaved (24 bytes each) in a single buffer,
+*       instead of separate position, texcoord and color buffers
+*
 *   DEPENDENCIES:
 *       raymath     - 3D math functionality (Vector3, Matrix, Quaternion)
 *       GLAD        - OpenGL extensions loading (OpenGL 3.3 Core only)
@@ -127,9 +131,12 @@
     #define MAX_BATCH_ELEMENTS            2048
 #endif
 
-#define MAX_BATCH_BUFFERING                  1      // Max number of buffers for batching (multi-buffering)
+#define MAX_BATCH_BUFFERING                  4      // Max number of buffers for batching (multi-buffering)
+#define MAX_TIMER_QUERIES                    8      // Max number of GPU timers that can be measured per frame
+#define MAX_TIMER_QUERY_BUFFERING            4      // Max number of frames a timer query result can be waited for
 #define MAX_MATRIX_STACK_SIZE               32      // Max size of Matrix stack
 #define MAX_DRAWCALL_REGISTERED            256      // Max draws by state changes (mode, texture)
+#define MAX_GLYPH_INSTANCES               4096      // Max number of glyphs drawn with one instanced draw call
 
 // Texture parameters (equivalent to OpenGL defines)
 #define RL_TEXTURE_WRAP_S               0x2802      // GL_TEXTURE_WRAP_S
@@ -471,10 +478,29 @@ RLAPI unsigned int rlLoadAttribBuffer(unsigned int vaoId, int shaderLoc, void *b
 RLAPI void rlglInit(int width, int height);           // Initialize rlgl (buffers, shaders, textures, states)
 RLAPI void rlglClose(void);                           // De-inititialize rlgl (buffers, shaders, textures)
 RLAPI void rlglDraw(void);                            // Update and draw default internal buffers
+RLAPI void rlglFinish(void);                          // Draw default internal buffers and wait for the GPU to complete all work
 
 RLAPI int rlGetVersion(void);                         // Returns current OpenGL version
 RLAPI bool rlCheckBufferLimit(int vCount);            // Check internal buffer overflow for a given number of vertex
 RLAPI void rlSetDebugMarker(const char *text);        // Set debug marker for analysis
+RLAPI bool rlTimerQuerySupported(void);               // Check if GPU timer queries are supported
+RLAPI void rlBeginTimerQuery(int timer);              // Begin measuring GPU time into a timer (only one can be active)
+RLAPI void rlEndTimerQuery(void);                     // End measuring GPU time into the active timer
+RLAPI void rlUpdateTimerQueries(void);                // Collect finished timer results and swap query buffers (once per frame)
+RLAPI double rlGetTimerQueryTime(int timer);          // Get latest measured GPU time of a timer (in milliseconds)
+RLAPI unsigned int rlGetGLCallsCount(void);           // Get number of GL calls issued since init (state changes, uniforms and draws)
+RLAPI unsigned int rlGetGLCallsSkipped(void);         // Get number of redundant GL calls skipped by the state cache since init
+
+// Uniform buffers management
+RLAPI bool rlUniformBufferSupported(void);            // Check if uniform buffer objects are supported
+RLAPI unsigned int rlLoadUniformBuffer(int size);     // Load uniform buffer of given size (contents undefined)
+RLAPI void rlUpdateUniformBuffer(unsigned int id, const void *data, int size); // Update uniform buffer contents (one upload)
+RLAPI bool rlSetShaderUniformBlock(Shader shader, const char *blockName, unsigned int id, int binding); // Bind uniform buffer to a shader uniform block
+RLAPI void rlUnloadUniformBuffer(unsigned int id);    // Unload uniform buffer from GPU memory
+RLAPI void rlDrawGlyph(unsigned int textureId, float x, float y, float width, float height,
+                       float u0, float v0, float u1, float v1, Color color); // Draw textured quad, batched as an instance if supported
+RLAPI void rlEnableGlyphDistanceField(void);          // Draw glyphs from signed distance field atlases (SDF fonts)
+RLAPI void rlDisableGlyphDistanceField(void);         // Draw glyphs from regular bitmap atlases
 RLAPI void rlLoadExtensions(void *loader);            // Load OpenGL extensions
 RLAPI Vector3 rlUnproject(Vector3 source, Matrix proj, Matrix view);  // Get world coordinates from screen coordinates
 
@@ -513,6 +539,9 @@ RLAPI void rlUnloadMesh(Mesh *mesh);                                      // Unl
 RLAPI char *LoadText(const char *fileName);                               // Load chars array from text file
 RLAPI Shader LoadShader(const char *vsFileName, const char *fsFileName);  // Load shader from files and bind default locations
 RLAPI Shader LoadShaderCode(char *vsCode, char *fsCode);                  // Load shader from code strings and bind default locations
+RLAPI Shader LoadShaderCodeAsync(char *vsCode, char *fsCode);             // Start loading shader from code strings, finish with FinishShaderLoading()
+RLAPI bool IsShaderLoadingDone(Shader shader);                            // Check if shader compilation has completed (never waits if parallel compile is supported)
+RLAPI Shader FinishShaderLoading(Shader shader);                          // Wait for shader compilation to complete and bind default locations
 RLAPI void UnloadShader(Shader shader);                                   // Unload shader from GPU memory (VRAM)
 
 RLAPI Shader GetShaderDefault(void);                                      // Get default shader
@@ -683,6 +712,10 @@ RLAPI int GetPixelDataSize(int width, int height, int format);// Get pixel data
     #define GL_TEXTURE_MAX_ANISOTROPY_EXT       0x84FE
 #endif
 
+#ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR            0x91B1
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_11)
     #define GL_UNSIGNED_SHORT_5_6_5             0x8363
     #define GL_UNSIGNED_SHORT_5_5_5_1           0x8034
@@ -708,6 +741,24 @@ RLAPI int GetPixelDataSize(int width, int height, int format);// Get pixel data
 #define DEFAULT_ATTRIB_TANGENT_NAME     "vertexTangent"     // shader-location = 4
 #define DEFAULT_ATTRIB_TEXCOORD2_NAME   "vertexTexCoord2"   // shader-location = 5
 
+// Distance between consecutive vertices in the default batch arrays
+// NOTE: When interleaved, the texcoords and colors arrays point into the vertices array
+#if defined(SUPPORT_INTERLEAVED_BATCH)
+    #define BATCH_VERTEX_SIZE           24      // Bytes per vertex: position (3 float), texcoord (2 float), color (4 byte)
+    #define BATCH_POSITION_STRIDE        6      // Floats between vertex positions
+    #define BATCH_TEXCOORD_STRIDE        6      // Floats between vertex texcoords
+    #define BATCH_COLOR_STRIDE          24      // Bytes between vertex colors
+#else
+    #define BATCH_POSITION_STRIDE        3
+    #define BATCH_TEXCOORD_STRIDE        2
+    #define BATCH_COLOR_STRIDE           4
+#endif
+
+// GL state cache limits
+#define MAX_STATE_TEXTURE_UNITS         16      // Texture units with cached 2D texture bindings
+#define MAX_STATE_SHADERS                8      // Shader programs with cached default uniforms (mvp, colDiffuse, texture0)
+#define STATE_UNKNOWN           0xFFFFFFFF      // Cached binding not known, next bind is always issued
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -728,8 +779,19 @@ typedef struct DynamicBuffer {
 #endif
     unsigned int vaoId;         // OpenGL Vertex Array Object id
     unsigned int vboId[4];      // OpenGL Vertex Buffer Objects id (4 types of vertex data)
+    void *mappedVbo[3];         // Persistently mapped position, texcoord and color buffers (NULL if not supported, only [0] if interleaved)
+#if defined(GRAPHICS_API_OPENGL_33)
+    GLsync fence;               // Signaled once the GPU is done with the last batch drawn from these buffers
+#endif
 } DynamicBuffer;
 
+// Glyph instance (one textured quad, expanded in the vertex shader)
+typedef struct GlyphInstance {
+    float dest[4];              // Destination rectangle (x, y, width, height)
+    float source[4];            // Source texture coordinates (u0, v0, u1, v1)
+    unsigned char color[4];     // Tint color (RGBA)
+} GlyphInstance;
+
 // Draw call type
 typedef struct DrawCall {
     int mode;                   // Drawing mode: LINES, TRIANGLES, QUADS
@@ -744,6 +806,24 @@ typedef struct DrawCall {
     //Matrix modelview;         // Modelview matrix for this draw
 } DrawCall;
 
+// GL state cache, used to skip redundant binds
+// NOTE: Only state changed through rlgl is tracked, it must be the only module issuing these calls
+typedef struct GLStateCache {
+    unsigned int program;       // Shader program in use
+    unsigned int vertexArray;   // Bound vertex array object
+    int activeTexture;          // Active texture unit index (-1 if unknown)
+    unsigned int textures[MAX_STATE_TEXTURE_UNITS];    // Bound 2D texture per texture unit
+    unsigned int framebuffer;   // Bound framebuffer
+    int viewport[4];            // Current viewport [x, y, w, h] (width -1 if unknown)
+} GLStateCache;
+
+// Default uniforms last uploaded to a shader program
+typedef struct ShaderUniformState {
+    unsigned int id;            // Shader program id (0 if the slot is free)
+    bool valid;                 // Uploaded values are still current on the program
+    Matrix mvp;                 // Last uploaded modelview-projection matrix
+} ShaderUniformState;
+
 #if defined(SUPPORT_VR_SIMULATOR)
 // VR Stereo rendering configuration for simulator
 typedef struct VrStereoConfig {
@@ -815,6 +895,36 @@ static bool texAnisotropicFilterSupported = false;  // Anisotropic texture filte
 static float maxAnisotropicLevel = 0.0f;            // Maximum anisotropy level supported (minimum is 2.0f)
 
 static bool debugMarkerSupported = false;   // Debug marker support
+static bool parallelShaderCompileSupported = false; // Shader compile status can be polled without waiting
+static bool uniformBufferSupported = false;         // Uniform buffer objects support
+static bool bufferStorageSupported = false;         // Persistently mapped buffers (and fences) support
+
+// Glyph batch, drawn with one instanced draw call per texture (OpenGL 3.3 only)
+static bool glyphInstancingSupported = false;
+static Shader glyphShader = { 0 };
+static Shader glyphDistanceFieldShader = { 0 };
+static unsigned int glyphVaoId = 0;
+static unsigned int glyphVboId = 0;
+static GlyphInstance *glyphInstances = NULL;
+static int glyphCount = 0;
+static unsigned int glyphTextureId = 0;
+
+// Distance field glyphs, drawn with the glyph instancing shader or through the default internal buffers
+static bool glyphDistanceField = false;
+static unsigned int distanceFieldFShaderId = 0;
+static Shader distanceFieldShader = { 0 };
+
+// GPU timer queries, multi-buffered so results are read frames later without stalling
+static bool timerQuerySupported = false;
+static unsigned int timerQueries[MAX_TIMER_QUERY_BUFFERING][MAX_TIMER_QUERIES] = { 0 };
+static bool timerQueriesPending[MAX_TIMER_QUERY_BUFFERING][MAX_TIMER_QUERIES] = { 0 };
+static double timerQueryTimes[MAX_TIMER_QUERIES] = { 0 };
+static int currentTimerQueryBuffer = 0;
+static int activeTimerQuery = -1;
+
+// Default uniforms cache, the batch only uploads the MVP matrix when it changes
+static ShaderUniformState shaderUniforms[MAX_STATE_SHADERS] = { 0 };
+static int shaderUniformsNext = 0;          // Slot replaced when all of them are in use
 
 #if defined(GRAPHICS_API_OPENGL_ES2)
 // NOTE: VAO functionality is exposed through extensions (OES)
@@ -837,6 +947,10 @@ static bool vrStereoRender = false;         // VR stereo rendering enabled/disab
 
 static int blendMode = 0;   // Track current blending mode
 
+static GLStateCache glState = { 0 };        // Cached GL bindings, redundant changes are skipped
+static unsigned int glCallsCount = 0;       // GL calls issued (state changes, uniform uploads and draws)
+static unsigned int glCallsSkipped = 0;     // GL calls skipped by the state cache
+
 // Default framebuffer size
 static int screenWidth;     // Default framebuffer width
 static int screenHeight;    // Default framebuffer height
@@ -847,16 +961,24 @@ static int screenHeight;    // Default framebuffer height
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 static unsigned int CompileShader(const char *shaderStr, int type);     // Compile custom shader and return shader id
 static unsigned int LoadShaderProgram(unsigned int vShaderId, unsigned int fShaderId);  // Load custom shader program
+static bool CheckShaderCompileStatus(unsigned int shader);              // Check shader compile status, log errors
+static bool CheckShaderProgramLinkStatus(unsigned int program);         // Check shader program link status, log errors
 
 static Shader LoadShaderDefault(void);      // Load default shader (just vertex positioning and texture coloring)
 static void SetShaderDefaultLocations(Shader *shader); // Bind default shader locations (attributes and uniforms)
 static void UnloadShaderDefault(void);      // Unload default shader
 
 static void LoadBuffersDefault(void);       // Load default internal buffers
+static void *AllocateBufferDefault(unsigned int *vboId, int size, const void *data); // Allocate storage for the bound default vertex buffer
+static void UpdateBufferDefault(unsigned int vboId, void *mapped, int capacity, int size, const void *data); // Write vertex data into a default vertex buffer
 static void UpdateBuffersDefault(void);     // Update default internal buffers (VAOs/VBOs) with vertex data
 static void DrawBuffersDefault(void);       // Draw default internal buffers vertex data
 static void UnloadBuffersDefault(void);     // Unload default internal buffers vertex data from CPU and GPU
 
+static void LoadGlyphBatch(void);           // Load glyph instancing and distance field shaders and buffers
+static void DrawGlyphBatch(void);           // Draw the queued glyph instances
+static void UnloadGlyphBatch(void);         // Unload glyph instancing and distance field shaders and buffers
+
 static void GenDrawCube(void);              // Generate and draw cube
 static void GenDrawQuad(void);              // Generate and draw quad
 
@@ -871,6 +993,23 @@ static int GenerateMipmaps(unsigned char *data, int baseWidth, int baseHeight);
 static Color *GenNextMipmap(Color *srcData, int srcWidth, int srcHeight);
 #endif
 
+static void ResetStateCache(void);          // Forget all cached GL state (bindings become unknown)
+static void BindTexture(unsigned int id);   // Bind 2D texture to the active texture unit (if not bound)
+static void DeleteTexture(unsigned int id); // Delete texture and reset its cached bindings
+static void SetViewport(int x, int y, int width, int height);   // Set viewport area (if changed)
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+static void UseProgram(unsigned int id);    // Use shader program (if not in use)
+static void BindVertexArray(unsigned int id);   // Bind vertex array object (if not bound)
+static void ActiveTexture(int unit);        // Activate texture unit by index (if not active)
+static void BindFramebuffer(unsigned int id);   // Bind framebuffer (if not bound)
+static void DeleteProgram(unsigned int id); // Delete shader program and forget its cached state
+static void DeleteFramebuffer(unsigned int id); // Delete framebuffer and reset its cached binding
+static void DeleteVertexArray(unsigned int id); // Delete vertex array object and reset its cached binding
+static void SetShaderDefaultUniforms(Shader shader, Matrix mvp);   // Upload batch uniforms (mvp, colDiffuse, texture0) if changed
+static void InvalidateShaderUniforms(unsigned int id);  // Forget the batch uniforms cached for a shader program
+#endif
+
 //----------------------------------------------------------------------------------
 // Module Functions Definition - Matrix operations
 //----------------------------------------------------------------------------------
@@ -1022,7 +1161,7 @@ void rlOrtho(double left, double right, double bottom, double top, double znear,
 // NOTE: Updates global variables: screenWidth, screenHeight
 void rlViewport(int x, int y, int width, int height)
 {
-    glViewport(x, y, width, height);
+    SetViewport(x, y, width, height);
 }
 
 //----------------------------------------------------------------------------------
@@ -1058,6 +1197,9 @@ void rlColor4f(float x, float y, float z, float w) { glColor4f(x, y, z, w); }
 // Initialize drawing mode (how to organize vertex)
 void rlBegin(int mode)
 {
+    // Queued glyphs are drawn first, so they stay below anything drawn after them
+    if (glyphCount > 0) DrawGlyphBatch();
+
     // Draw mode can be RL_LINES, RL_TRIANGLES and RL_QUADS
     // NOTE: In all three cases, vertex are accumulated over default internal vertex buffer
     if (draws[drawsCounter - 1].mode != mode)
@@ -1104,10 +1246,11 @@ void rlEnd(void)
 
         for (int i = 0; i < addColors; i++)
         {
-            vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter] = vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter - 4];
-            vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 1] = vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter - 3];
-            vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 2] = vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter - 2];
-            vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 3] = vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter - 1];
+            unsigned char *color = vertexData[currentBuffer].colors + BATCH_COLOR_STRIDE*vertexData[currentBuffer].cCounter;
+            color[0] = color[-BATCH_COLOR_STRIDE];
+            color[1] = color[-BATCH_COLOR_STRIDE + 1];
+            color[2] = color[-BATCH_COLOR_STRIDE + 2];
+            color[3] = color[-BATCH_COLOR_STRIDE + 3];
             vertexData[currentBuffer].cCounter++;
         }
     }
@@ -1119,8 +1262,8 @@ void rlEnd(void)
 
         for (int i = 0; i < addTexCoords; i++)
         {
-            vertexData[currentBuffer].texcoords[2*vertexData[currentBuffer].tcCounter] = 0.0f;
-            vertexData[currentBuffer].texcoords[2*vertexData[currentBuffer].tcCounter + 1] = 0.0f;
+            vertexData[currentBuffer].texcoords[BATCH_TEXCOORD_STRIDE*vertexData[currentBuffer].tcCounter] = 0.0f;
+            vertexData[currentBuffer].texcoords[BATCH_TEXCOORD_STRIDE*vertexData[currentBuffer].tcCounter + 1] = 0.0f;
             vertexData[currentBuffer].tcCounter++;
         }
     }
@@ -1156,9 +1299,9 @@ void rlVertex3f(float x, float y, float z)
     // Verify that MAX_BATCH_ELEMENTS limit not reached
     if (vertexData[currentBuffer].vCounter < (MAX_BATCH_ELEMENTS*4))
     {
-        vertexData[currentBuffer].vertices[3*vertexData[currentBuffer].vCounter] = vec.x;
-        vertexData[currentBuffer].vertices[3*vertexData[currentBuffer].vCounter + 1] = vec.y;
-        vertexData[currentBuffer].vertices[3*vertexData[currentBuffer].vCounter + 2] = vec.z;
+        vertexData[currentBuffer].vertices[BATCH_POSITION_STRIDE*vertexData[currentBuffer].vCounter] = vec.x;
+        vertexData[currentBuffer].vertices[BATCH_POSITION_STRIDE*vertexData[currentBuffer].vCounter + 1] = vec.y;
+        vertexData[currentBuffer].vertices[BATCH_POSITION_STRIDE*vertexData[currentBuffer].vCounter + 2] = vec.z;
         vertexData[currentBuffer].vCounter++;
 
         draws[drawsCounter - 1].vertexCount++;
@@ -1182,8 +1325,8 @@ void rlVertex2i(int x, int y)
 // NOTE: Texture coordinates are limited to QUADS only
 void rlTexCoord2f(float x, float y)
 {
-    vertexData[currentBuffer].texcoords[2*vertexData[currentBuffer].tcCounter] = x;
-    vertexData[currentBuffer].texcoords[2*vertexData[currentBuffer].tcCounter + 1] = y;
+    vertexData[currentBuffer].texcoords[BATCH_TEXCOORD_STRIDE*vertexData[currentBuffer].tcCounter] = x;
+    vertexData[currentBuffer].texcoords[BATCH_TEXCOORD_STRIDE*vertexData[currentBuffer].tcCounter + 1] = y;
     vertexData[currentBuffer].tcCounter++;
 }
 
@@ -1197,10 +1340,10 @@ void rlNormal3f(float x, float y, float z)
 // Define one vertex (color)
 void rlColor4ub(byte x, byte y, byte z, byte w)
 {
-    vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter] = x;
-    vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 1] = y;
-    vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 2] = z;
-    vertexData[currentBuffer].colors[4*vertexData[currentBuffer].cCounter + 3] = w;
+    vertexData[currentBuffer].colors[BATCH_COLOR_STRIDE*vertexData[currentBuffer].cCounter] = x;
+    vertexData[currentBuffer].colors[BATCH_COLOR_STRIDE*vertexData[currentBuffer].cCounter + 1] = y;
+    vertexData[currentBuffer].colors[BATCH_COLOR_STRIDE*vertexData[currentBuffer].cCounter + 2] = z;
+    vertexData[currentBuffer].colors[BATCH_COLOR_STRIDE*vertexData[currentBuffer].cCounter + 3] = w;
     vertexData[currentBuffer].cCounter++;
 }
 
@@ -1227,7 +1370,7 @@ void rlEnableTexture(unsigned int id)
 {
 #if defined(GRAPHICS_API_OPENGL_11)
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, id);
+    BindTexture(id);
 #endif
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
@@ -1267,7 +1410,7 @@ void rlDisableTexture(void)
 {
 #if defined(GRAPHICS_API_OPENGL_11)
     glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 #else
     // NOTE: If quads batch limit is reached,
     // we force a draw call and next batch starts
@@ -1278,7 +1421,7 @@ void rlDisableTexture(void)
 // Set texture parameters (wrap mode/filter mode)
 void rlTextureParameters(unsigned int id, int param, int value)
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    BindTexture(id);
 
     switch (param)
     {
@@ -1310,14 +1453,14 @@ void rlTextureParameters(unsigned int id, int param, int value)
         default: break;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 }
 
 // Enable rendering to texture (fbo)
 void rlEnableRenderTexture(unsigned int id)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glBindFramebuffer(GL_FRAMEBUFFER, id);
+    BindFramebuffer(id);
 
     //glDisable(GL_CULL_FACE);    // Allow double side drawing for texture flipping
     //glCullFace(GL_FRONT);
@@ -1328,7 +1471,7 @@ void rlEnableRenderTexture(unsigned int id)
 void rlDisableRenderTexture(void)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     //glEnable(GL_CULL_FACE);
     //glCullFace(GL_BACK);
@@ -1380,21 +1523,21 @@ void rlDisableWireMode(void)
 // Unload texture from GPU memory
 void rlDeleteTextures(unsigned int id)
 {
-    if (id > 0) glDeleteTextures(1, &id);
+    if (id > 0) DeleteTexture(id);
 }
 
 // Unload render texture from GPU memory
 void rlDeleteRenderTextures(RenderTexture2D target)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    if (target.texture.id > 0) glDeleteTextures(1, &target.texture.id);
+    if (target.texture.id > 0) DeleteTexture(target.texture.id);
     if (target.depth.id > 0)
     {
-        if (target.depthTexture) glDeleteTextures(1, &target.depth.id);
+        if (target.depthTexture) DeleteTexture(target.depth.id);
         else glDeleteRenderbuffers(1, &target.depth.id);
     }
 
-    if (target.id > 0) glDeleteFramebuffers(1, &target.id);
+    if (target.id > 0) DeleteFramebuffer(target.id);
 
     TraceLog(LOG_INFO, "[FBO ID %i] Unloaded render texture data from VRAM (GPU)", target.id);
 #endif
@@ -1404,7 +1547,7 @@ void rlDeleteRenderTextures(RenderTexture2D target)
 void rlDeleteShader(unsigned int id)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    if (id != 0) glDeleteProgram(id);
+    if (id != 0) DeleteProgram(id);
 #endif
 }
 
@@ -1414,7 +1557,7 @@ void rlDeleteVertexArrays(unsigned int id)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     if (vaoSupported)
     {
-        if (id != 0) glDeleteVertexArrays(1, &id);
+        if (id != 0) DeleteVertexArray(id);
         TraceLog(LOG_INFO, "[VAO ID %i] Unloaded model data from VRAM (GPU)", id);
     }
 #endif
@@ -1467,6 +1610,9 @@ void rlUpdateBuffer(int bufferId, void *data, int dataSize)
 // Initialize rlgl: OpenGL extensions, default buffers/shaders/textures, OpenGL states
 void rlglInit(int width, int height)
 {
+    // Nothing is known about the GL state until rlgl sets it
+    ResetStateCache();
+
     // Check OpenGL information and capabilities
     //------------------------------------------------------------------------------
 
@@ -1513,6 +1659,14 @@ void rlglInit(int width, int height)
     texFloatSupported = true;
     texDepthSupported = true;
 
+    #if !defined(GRAPHICS_API_OPENGL_21)
+    // Timer queries are core since OpenGL 3.3
+    timerQuerySupported = true;
+
+    // Uniform buffer objects are core since OpenGL 3.1
+    uniformBufferSupported = true;
+    #endif
+
     // We get a list of available extensions and we check for some of them (compressed textures)
     // NOTE: We don't need to check again supported extensions but we do (GLAD already dealt with that)
     glGetIntegerv(GL_NUM_EXTENSIONS, &numExt);
@@ -1613,10 +1767,30 @@ void rlglInit(int width, int height)
 
         // Debug marker support
         if (strcmp(extList[i], (const char *)"GL_EXT_debug_marker") == 0) debugMarkerSupported = true;
+
+        // Parallel shader compile support
+        if ((strcmp(extList[i], (const char *)"GL_KHR_parallel_shader_compile") == 0) ||
+            (strcmp(extList[i], (const char *)"GL_ARB_parallel_shader_compile") == 0)) parallelShaderCompileSupported = true;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Timer queries support
+        if (strcmp(extList[i], (const char *)"GL_ARB_timer_query") == 0) timerQuerySupported = true;
+
+        // Uniform buffer objects support
+        if (strcmp(extList[i], (const char *)"GL_ARB_uniform_buffer_object") == 0) uniformBufferSupported = true;
+
+        // Persistently mapped buffers support
+        if (strcmp(extList[i], (const char *)"GL_ARB_buffer_storage") == 0) bufferStorageSupported = true;
+#endif
     }
 
     RL_FREE(extList);
 
+#if defined(GRAPHICS_API_OPENGL_33)
+    // NOTE: Writing into persistently mapped buffers is only safe with fences (OpenGL 3.2)
+    if ((glBufferStorage == NULL) || (glFenceSync == NULL)) bufferStorageSupported = false;
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_ES2)
     if (vaoSupported) TraceLog(LOG_INFO, "[EXTENSION] VAO extension detected, VAO functions initialized successfully");
     else TraceLog(LOG_WARNING, "[EXTENSION] VAO extension not found, VAO usage not supported");
@@ -1635,6 +1809,17 @@ void rlglInit(int width, int height)
     if (texMirrorClampSupported) TraceLog(LOG_INFO, "[EXTENSION] Mirror clamp wrap texture mode supported");
 
     if (debugMarkerSupported) TraceLog(LOG_INFO, "[EXTENSION] Debug Marker supported");
+    if (parallelShaderCompileSupported) TraceLog(LOG_INFO, "[EXTENSION] Parallel shader compile supported");
+    if (uniformBufferSupported) TraceLog(LOG_INFO, "[EXTENSION] Uniform buffer objects supported");
+    if (bufferStorageSupported) TraceLog(LOG_INFO, "[EXTENSION] Persistently mapped buffers supported");
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (timerQuerySupported)
+    {
+        glGenQueries(MAX_TIMER_QUERY_BUFFERING*MAX_TIMER_QUERIES, &timerQueries[0][0]);
+        TraceLog(LOG_INFO, "[EXTENSION] Timer queries supported");
+    }
+#endif
 
     // Initialize buffers, default shaders and default textures
     //----------------------------------------------------------
@@ -1652,6 +1837,9 @@ void rlglInit(int width, int height)
     // Init default vertex arrays buffers
     LoadBuffersDefault();
 
+    // Init glyph instancing (if supported) and distance field glyphs
+    LoadGlyphBatch();
+
     // Init transformations matrix accumulator
     transformMatrix = MatrixIdentity();
 
@@ -1720,12 +1908,17 @@ void rlglInit(int width, int height)
 void rlglClose(void)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    UnloadGlyphBatch();                 // Unload glyph instancing (uses the default fragment shader)
     UnloadShaderDefault();              // Unload default shader
     UnloadBuffersDefault();             // Unload default buffers
-    glDeleteTextures(1, &defaultTextureId); // Unload default texture
+    DeleteTexture(defaultTextureId);    // Unload default texture
 
     TraceLog(LOG_INFO, "[TEX ID %i] Unloaded texture data (base white texture) from VRAM", defaultTextureId);
 
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (timerQuerySupported) glDeleteQueries(MAX_TIMER_QUERY_BUFFERING*MAX_TIMER_QUERIES, &timerQueries[0][0]);
+#endif
+
     RL_FREE(draws);
 #endif
 }
@@ -1740,9 +1933,19 @@ void rlglDraw(void)
         UpdateBuffersDefault();
         DrawBuffersDefault();       // NOTE: Stereo rendering is checked inside
     }
+
+    if (glyphCount > 0) DrawGlyphBatch();
 #endif
 }
 
+// Draw internal buffers and wait for the GPU to complete all work
+// NOTE: Right after a buffer swap with vsync, this also waits for the swap to happen
+void rlglFinish(void)
+{
+    rlglDraw();
+    glFinish();
+}
+
 // Returns current OpenGL version
 int rlGetVersion(void)
 {
@@ -1779,6 +1982,262 @@ void rlSetDebugMarker(const char *text)
 #endif
 }
 
+// Check if GPU timer queries are supported
+bool rlTimerQuerySupported(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    return timerQuerySupported;
+#else
+    return false;
+#endif
+}
+
+// Begin measuring GPU time into a timer
+// NOTE: Only one timer can be active at a time, nested calls are ignored
+void rlBeginTimerQuery(int timer)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!timerQuerySupported || (timer < 0) || (timer >= MAX_TIMER_QUERIES) || (activeTimerQuery != -1)) return;
+
+    // NOTE: If the GPU is more than MAX_TIMER_QUERY_BUFFERING frames behind, the query from that
+    // long ago is still pending, and this frame is not measured so its result is not discarded
+    if (timerQueriesPending[currentTimerQueryBuffer][timer]) return;
+
+    // Batched draws are flushed first, so they are not measured with this timer
+    rlglDraw();
+
+    glBeginQuery(GL_TIME_ELAPSED, timerQueries[currentTimerQueryBuffer][timer]);
+    activeTimerQuery = timer;
+#endif
+}
+
+// End measuring GPU time into the active timer
+void rlEndTimerQuery(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!timerQuerySupported || (activeTimerQuery == -1)) return;
+
+    rlglDraw();
+
+    glEndQuery(GL_TIME_ELAPSED);
+    timerQueriesPending[currentTimerQueryBuffer][activeTimerQuery] = true;
+    activeTimerQuery = -1;
+#endif
+}
+
+// Collect finished timer results and swap query buffers
+// NOTE: Results are only read when available, so the GPU is never waited on, and queries
+// stay pending until then, so slow frames are reported late instead of being dropped
+void rlUpdateTimerQueries(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!timerQuerySupported) return;
+
+    // Oldest buffer first, so the latest available result of each timer is kept
+    for (int j = 1; j <= MAX_TIMER_QUERY_BUFFERING; j++)
+    {
+        int buffer = (currentTimerQueryBuffer + j)%MAX_TIMER_QUERY_BUFFERING;
+
+        for (int i = 0; i < MAX_TIMER_QUERIES; i++)
+        {
+            if (!timerQueriesPending[buffer][i]) continue;
+
+            GLint available = 0;
+            glGetQueryObjectiv(timerQueries[buffer][i], GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if (available)
+            {
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(timerQueries[buffer][i], GL_QUERY_RESULT, &elapsed);
+                timerQueryTimes[i] = (double)elapsed/1000000.0;
+                timerQueriesPending[buffer][i] = false;
+            }
+        }
+    }
+
+    currentTimerQueryBuffer = (currentTimerQueryBuffer + 1)%MAX_TIMER_QUERY_BUFFERING;
+#endif
+}
+
+// Get latest measured GPU time of a timer (in milliseconds)
+double rlGetTimerQueryTime(int timer)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if ((timer >= 0) && (timer < MAX_TIMER_QUERIES)) return timerQueryTimes[timer];
+#endif
+    return 0.0;
+}
+
+// Get number of GL calls issued since init (state changes, uniform uploads and draws)
+// NOTE: The counter wraps around, the difference between two frames is still correct
+unsigned int rlGetGLCallsCount(void)
+{
+    return glCallsCount;
+}
+
+// Get number of GL calls skipped by the state cache since init
+unsigned int rlGetGLCallsSkipped(void)
+{
+    return glCallsSkipped;
+}
+
+// Check if uniform buffer objects are supported
+bool rlUniformBufferSupported(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    return uniformBufferSupported;
+#else
+    return false;
+#endif
+}
+
+// Load uniform buffer of given size, contents are undefined until updated
+unsigned int rlLoadUniformBuffer(int size)
+{
+    unsigned int id = 0;
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!uniformBufferSupported) return 0;
+
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_UNIFORM_BUFFER, id);
+    glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#endif
+
+    return id;
+}
+
+// Update uniform buffer contents
+// NOTE: All the data is uploaded with a single call, uniform blocks using it see the changes on their next draw
+void rlUpdateUniformBuffer(unsigned int id, const void *data, int size)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (id == 0) return;
+
+    rlglDraw();     // Queued draws must still use the previous contents
+
+    glBindBuffer(GL_UNIFORM_BUFFER, id);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#endif
+}
+
+// Bind uniform buffer to a shader uniform block, through the given binding point
+// NOTE: Returns false if the shader has no such block (e.g. GLSL versions without uniform blocks)
+bool rlSetShaderUniformBlock(Shader shader, const char *blockName, unsigned int id, int binding)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (!uniformBufferSupported || (id == 0)) return false;
+
+    unsigned int blockIndex = glGetUniformBlockIndex(shader.id, blockName);
+    if (blockIndex == GL_INVALID_INDEX) return false;
+
+    glUniformBlockBinding(shader.id, blockIndex, binding);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Unload uniform buffer from GPU memory (VRAM)
+void rlUnloadUniformBuffer(unsigned int id)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (id != 0) glDeleteBuffers(1, &id);
+#endif
+}
+
+// Draw glyphs from signed distance field atlases
+// NOTE: Without instancing support, the distance field shader is used for the default internal
+// buffers until it is disabled: shapes (white default texture) are drawn unchanged, but other
+// textures only keep their alpha, thresholded at 0.5
+void rlEnableGlyphDistanceField(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (glyphDistanceField) return;
+
+    rlglDraw();
+    glyphDistanceField = true;
+
+    if (!glyphInstancingSupported && (currentShader.id == defaultShader.id) && (distanceFieldShader.id > 0)) currentShader = distanceFieldShader;
+#endif
+}
+
+// Draw glyphs from regular bitmap atlases
+void rlDisableGlyphDistanceField(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (!glyphDistanceField) return;
+
+    rlglDraw();
+    glyphDistanceField = false;
+
+    if (currentShader.id == distanceFieldShader.id) currentShader = defaultShader;
+#endif
+}
+
+// Draw textured quad (a glyph), from texture coordinates (u0, v0)-(u1, v1) into the rectangle at (x, y)
+// NOTE: With instancing support, consecutive glyphs from the same texture are queued and drawn
+// with one instanced draw call, otherwise the quad goes through the default internal buffers
+void rlDrawGlyph(unsigned int textureId, float x, float y, float width, float height,
+                 float u0, float v0, float u1, float v1, Color color)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    bool instanced = glyphInstancingSupported && !useTransformMatrix && (currentShader.id == defaultShader.id);
+#if defined(SUPPORT_VR_SIMULATOR)
+    if (vrStereoRender) instanced = false;
+#endif
+
+    if (instanced)
+    {
+        // Anything already in the default internal buffers is drawn below the glyphs
+        if (vertexData[currentBuffer].vCounter > 0) rlglDraw();
+        if ((glyphCount > 0) && ((glyphTextureId != textureId) || (glyphCount >= MAX_GLYPH_INSTANCES))) DrawGlyphBatch();
+
+        GlyphInstance *glyph = &glyphInstances[glyphCount];
+        glyph->dest[0] = x;
+        glyph->dest[1] = y;
+        glyph->dest[2] = width;
+        glyph->dest[3] = height;
+        glyph->source[0] = u0;
+        glyph->source[1] = v0;
+        glyph->source[2] = u1;
+        glyph->source[3] = v1;
+        glyph->color[0] = color.r;
+        glyph->color[1] = color.g;
+        glyph->color[2] = color.b;
+        glyph->color[3] = color.a;
+
+        glyphTextureId = textureId;
+        glyphCount++;
+        return;
+    }
+#endif
+
+    rlCheckBufferLimit(4);
+
+    rlEnableTexture(textureId);
+    rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+
+        rlTexCoord2f(u0, v0);
+        rlVertex2f(x, y);
+
+        rlTexCoord2f(u0, v1);
+        rlVertex2f(x, y + height);
+
+        rlTexCoord2f(u1, v1);
+        rlVertex2f(x + width, y + height);
+
+        rlTexCoord2f(u1, v0);
+        rlVertex2f(x + width, y);
+    rlEnd();
+    rlDisableTexture();
+}
+
 // Load OpenGL extensions
 // NOTE: External loader function could be passed as a pointer
 void rlLoadExtensions(void *loader)
@@ -1828,7 +2287,7 @@ Vector3 rlUnproject(Vector3 source, Matrix proj, Matrix view)
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
 unsigned int rlLoadTexture(void *data, int width, int height, int format, int mipmapCount)
 {
-    glBindTexture(GL_TEXTURE_2D, 0);    // Free any old binding
+    BindTexture(0);    // Free any old binding
 
     unsigned int id = 0;
 
@@ -1881,7 +2340,7 @@ unsigned int rlLoadTexture(void *data, int width, int height, int format, int mi
     //glActiveTexture(GL_TEXTURE0);     // If not defined, using GL_TEXTURE0 by default (shader texture)
 #endif
 
-    glBindTexture(GL_TEXTURE_2D, id);
+    BindTexture(id);
 
     int mipWidth = width;
     int mipHeight = height;
@@ -1971,7 +2430,7 @@ unsigned int rlLoadTexture(void *data, int width, int height, int format, int mi
     // NOTE: If mipmaps were not in data, they are not generated automatically
 
     // Unbind current texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 
     if (id > 0) TraceLog(LOG_INFO, "[TEX ID %i] Texture created successfully (%ix%i - %i mipmaps)", id, width, height, mipmapCount);
     else TraceLog(LOG_WARNING, "Texture could not be created");
@@ -2011,7 +2470,7 @@ unsigned int rlLoadTextureDepth(int width, int height, int bits, bool useRenderB
     if (!useRenderBuffer && texDepthSupported)
     {
         glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
+        BindTexture(id);
         glTexImage2D(GL_TEXTURE_2D, 0, glInternalFormat, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -2019,7 +2478,7 @@ unsigned int rlLoadTextureDepth(int width, int height, int bits, bool useRenderB
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
+        BindTexture(0);
     }
     else
     {
@@ -2098,7 +2557,7 @@ unsigned int rlLoadTextureCubemap(void *data, int size, int format)
 // NOTE: We don't know safely if internal texture format is the expected one...
 void rlUpdateTexture(unsigned int id, int width, int height, int format, const void *data)
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    BindTexture(id);
 
     unsigned int glInternalFormat, glFormat, glType;
     rlGetGlTextureFormats(format, &glInternalFormat, &glFormat, &glType);
@@ -2165,7 +2624,7 @@ void rlGetGlTextureFormats(int format, unsigned int *glInternalFormat, unsigned
 // Unload texture from GPU memory
 void rlUnloadTexture(unsigned int id)
 {
-    if (id > 0) glDeleteTextures(1, &id);
+    if (id > 0) DeleteTexture(id);
 }
 
 // Load a texture to be used for rendering (fbo with default color and depth attachments)
@@ -2179,7 +2638,7 @@ RenderTexture2D rlLoadRenderTexture(int width, int height, int format, int depth
 
     // Create the framebuffer object
     glGenFramebuffers(1, &target.id);
-    glBindFramebuffer(GL_FRAMEBUFFER, target.id);
+    BindFramebuffer(target.id);
 
     // Create fbo color texture attachment
     //-----------------------------------------------------------------------------------------------------
@@ -2217,7 +2676,7 @@ RenderTexture2D rlLoadRenderTexture(int width, int height, int format, int depth
     if (rlRenderTextureComplete(target)) TraceLog(LOG_INFO, "[FBO ID %i] Framebuffer object created successfully", target.id);
     //-----------------------------------------------------------------------------------------------------
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 #endif
 
     return target;
@@ -2228,7 +2687,7 @@ RenderTexture2D rlLoadRenderTexture(int width, int height, int format, int depth
 void rlRenderTextureAttach(RenderTexture2D target, unsigned int id, int attachType)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glBindFramebuffer(GL_FRAMEBUFFER, target.id);
+    BindFramebuffer(target.id);
 
     if (attachType == 0) glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, id, 0);
     else if (attachType == 1)
@@ -2237,7 +2696,7 @@ void rlRenderTextureAttach(RenderTexture2D target, unsigned int id, int attachTy
         else glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, id);
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 #endif
 }
 
@@ -2247,7 +2706,7 @@ bool rlRenderTextureComplete(RenderTexture target)
     bool result = false;
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glBindFramebuffer(GL_FRAMEBUFFER, target.id);
+    BindFramebuffer(target.id);
 
     GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
 
@@ -2265,7 +2724,7 @@ bool rlRenderTextureComplete(RenderTexture target)
         }
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     result = (status == GL_FRAMEBUFFER_COMPLETE);
 #endif
@@ -2276,7 +2735,7 @@ bool rlRenderTextureComplete(RenderTexture target)
 // Generate mipmap data for selected texture
 void rlGenerateMipmaps(Texture2D *texture)
 {
-    glBindTexture(GL_TEXTURE_2D, texture->id);
+    BindTexture(texture->id);
 
     // Check if texture is power-of-two (POT)
     bool texIsPOT = false;
@@ -2340,7 +2799,7 @@ void rlGenerateMipmaps(Texture2D *texture)
 #endif
     else TraceLog(LOG_WARNING, "[TEX ID %i] Mipmaps can not be generated", texture->id);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 }
 
 // Upload vertex data into a VAO (if supported) and VBO
@@ -2370,7 +2829,7 @@ void rlLoadMesh(Mesh *mesh, bool dynamic)
     {
         // Initialize Quads VAO (Buffer A)
         glGenVertexArrays(1, &mesh->vaoId);
-        glBindVertexArray(mesh->vaoId);
+        BindVertexArray(mesh->vaoId);
     }
 
     // NOTE: Attributes must be uploaded considering default locations points
@@ -2481,7 +2940,7 @@ unsigned int rlLoadAttribBuffer(unsigned int vaoId, int shaderLoc, void *buffer,
     int drawHint = GL_STATIC_DRAW;
     if (dynamic) drawHint = GL_DYNAMIC_DRAW;
 
-    if (vaoSupported) glBindVertexArray(vaoId);
+    if (vaoSupported) BindVertexArray(vaoId);
 
     glGenBuffers(1, &id);
     glBindBuffer(GL_ARRAY_BUFFER, id);
@@ -2489,7 +2948,7 @@ unsigned int rlLoadAttribBuffer(unsigned int vaoId, int shaderLoc, void *buffer,
     glVertexAttribPointer(shaderLoc, 2, GL_FLOAT, 0, 0, 0);
     glEnableVertexAttribArray(shaderLoc);
 
-    if (vaoSupported) glBindVertexArray(0);
+    if (vaoSupported) BindVertexArray(0);
 #endif
 
     return id;
@@ -2500,7 +2959,7 @@ void rlUpdateMesh(Mesh mesh, int buffer, int numVertex)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // Activate mesh VAO
-    if (vaoSupported) glBindVertexArray(mesh.vaoId);
+    if (vaoSupported) BindVertexArray(mesh.vaoId);
 
     switch (buffer)
     {
@@ -2548,7 +3007,7 @@ void rlUpdateMesh(Mesh mesh, int buffer, int numVertex)
     }
 
     // Unbind the current VAO
-    if (vaoSupported) glBindVertexArray(0);
+    if (vaoSupported) BindVertexArray(0);
 
     // Another option would be using buffer mapping...
     //mesh.vertices = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
@@ -2562,7 +3021,7 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
 {
 #if defined(GRAPHICS_API_OPENGL_11)
     glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, material.maps[MAP_DIFFUSE].texture.id);
+    BindTexture(material.maps[MAP_DIFFUSE].texture.id);
 
     // NOTE: On OpenGL 1.1 we use Vertex Arrays to draw model
     glEnableClientState(GL_VERTEX_ARRAY);                   // Enable vertex array
@@ -2589,12 +3048,12 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     if (mesh.colors != NULL) glDisableClientState(GL_NORMAL_ARRAY);     // Disable colors array
 
     glDisable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 #endif
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // Bind shader program
-    glUseProgram(material.shader.id);
+    UseProgram(material.shader.id);
 
     // Matrices and other values required by shader
     //-----------------------------------------------------
@@ -2632,16 +3091,16 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     {
         if (material.maps[i].texture.id > 0)
         {
-            glActiveTexture(GL_TEXTURE0 + i);
+            ActiveTexture(i);
             if ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP)) glBindTexture(GL_TEXTURE_CUBE_MAP, material.maps[i].texture.id);
-            else glBindTexture(GL_TEXTURE_2D, material.maps[i].texture.id);
+            else BindTexture(material.maps[i].texture.id);
 
             glUniform1i(material.shader.locs[LOC_MAP_DIFFUSE + i], i);
         }
     }
 
     // Bind vertex array objects (or VBOs)
-    if (vaoSupported) glBindVertexArray(mesh.vaoId);
+    if (vaoSupported) BindVertexArray(mesh.vaoId);
     else
     {
         // Bind mesh VBO data: vertex position (shader-location = 0)
@@ -2720,18 +3179,23 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
         // Draw call!
         if (mesh.indices != NULL) glDrawElements(GL_TRIANGLES, mesh.triangleCount*3, GL_UNSIGNED_SHORT, 0); // Indexed vertices draw
         else glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
+
+        glCallsCount += 2;
     }
 
+    // The material uniforms replaced the ones cached for the batch
+    InvalidateShaderUniforms(material.shader.id);
+
     // Unbind all binded texture maps
     for (int i = 0; i < MAX_MATERIAL_MAPS; i++)
     {
-        glActiveTexture(GL_TEXTURE0 + i);       // Set shader active texture
+        ActiveTexture(i);       // Set shader active texture
         if ((i == MAP_IRRADIANCE) || (i == MAP_PREFILTER) || (i == MAP_CUBEMAP)) glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-        else glBindTexture(GL_TEXTURE_2D, 0);   // Unbind current active texture
+        else BindTexture(0);   // Unbind current active texture
     }
 
     // Unind vertex array objects (or VBOs)
-    if (vaoSupported) glBindVertexArray(0);
+    if (vaoSupported) BindVertexArray(0);
     else
     {
         glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -2739,7 +3203,7 @@ void rlDrawMesh(Mesh mesh, Material material, Matrix transform)
     }
 
     // Unbind shader program
-    glUseProgram(0);
+    UseProgram(0);
 
     // Restore projection/modelview matrices
     // NOTE: In stereo rendering matrices are being modified to fit every eye
@@ -2810,7 +3274,7 @@ void *rlReadTexturePixels(Texture2D texture)
     void *pixels = NULL;
 
 #if defined(GRAPHICS_API_OPENGL_11) || defined(GRAPHICS_API_OPENGL_33)
-    glBindTexture(GL_TEXTURE_2D, texture.id);
+    BindTexture(texture.id);
 
     // NOTE: Using texture.id, we can retrieve some texture info (but not on OpenGL ES 2.0)
     // Possible texture info: GL_TEXTURE_RED_SIZE, GL_TEXTURE_GREEN_SIZE, GL_TEXTURE_BLUE_SIZE, GL_TEXTURE_ALPHA_SIZE
@@ -2836,7 +3300,7 @@ void *rlReadTexturePixels(Texture2D texture)
     }
     else TraceLog(LOG_WARNING, "Texture data retrieval not suported for pixel format");
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindTexture(0);
 #endif
 
 #if defined(GRAPHICS_API_OPENGL_ES2)
@@ -2849,8 +3313,8 @@ void *rlReadTexturePixels(Texture2D texture)
     // NOTE: This behaviour could be conditioned by graphic driver...
     RenderTexture2D fbo = rlLoadRenderTexture(texture.width, texture.height, UNCOMPRESSED_R8G8B8A8, 16, false);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo.id);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    BindFramebuffer(fbo.id);
+    BindTexture(0);
 
     // Attach our texture to FBO
     // NOTE: Previoust attached texture is automatically detached
@@ -2869,7 +3333,7 @@ void *rlReadTexturePixels(Texture2D texture)
     // Re-attach internal FBO color texture before deleting it
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fbo.texture.id, 0);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     // Clean up temporal fbo
     rlDeleteRenderTextures(fbo);
@@ -3022,6 +3486,117 @@ Shader LoadShaderCode(char *vsCode, char *fsCode)
     return shader;
 }
 
+// Start loading shader from code strings, finish with FinishShaderLoading()
+// NOTE: Shaders are compiled and linked without querying their status, so the driver
+// can do the work in the background (or postpone it) while the application keeps drawing
+Shader LoadShaderCodeAsync(char *vsCode, char *fsCode)
+{
+    Shader shader = { 0 };
+
+    // NOTE: All locations must be reseted to -1 (no location)
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) shader.locs[i] = -1;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if ((vsCode == NULL) && (fsCode == NULL)) shader = defaultShader;
+    else
+    {
+        unsigned int vertexShaderId = defaultVShaderId;
+        unsigned int fragmentShaderId = defaultFShaderId;
+
+        if (vsCode != NULL)
+        {
+            vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
+            glShaderSource(vertexShaderId, 1, (const char **)&vsCode, NULL);
+            glCompileShader(vertexShaderId);
+        }
+
+        if (fsCode != NULL)
+        {
+            fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
+            glShaderSource(fragmentShaderId, 1, (const char **)&fsCode, NULL);
+            glCompileShader(fragmentShaderId);
+        }
+
+        shader.id = glCreateProgram();
+
+        glAttachShader(shader.id, vertexShaderId);
+        glAttachShader(shader.id, fragmentShaderId);
+
+        // NOTE: Default attribute shader locations must be binded before linking
+        glBindAttribLocation(shader.id, 0, DEFAULT_ATTRIB_POSITION_NAME);
+        glBindAttribLocation(shader.id, 1, DEFAULT_ATTRIB_TEXCOORD_NAME);
+        glBindAttribLocation(shader.id, 2, DEFAULT_ATTRIB_NORMAL_NAME);
+        glBindAttribLocation(shader.id, 3, DEFAULT_ATTRIB_COLOR_NAME);
+        glBindAttribLocation(shader.id, 4, DEFAULT_ATTRIB_TANGENT_NAME);
+        glBindAttribLocation(shader.id, 5, DEFAULT_ATTRIB_TEXCOORD2_NAME);
+
+        glLinkProgram(shader.id);
+
+        // NOTE: Shaders stay attached until FinishShaderLoading(), so their logs can be read
+    }
+#endif
+
+    return shader;
+}
+
+// Check if shader compilation has completed
+// NOTE: Without parallel shader compile support there is no way to ask without
+// waiting, so the shader is reported done and FinishShaderLoading() will wait
+bool IsShaderLoadingDone(Shader shader)
+{
+    bool done = true;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (parallelShaderCompileSupported && (shader.id != defaultShader.id))
+    {
+        GLint completed = GL_TRUE;
+        glGetProgramiv(shader.id, GL_COMPLETION_STATUS_KHR, &completed);
+        done = (completed == GL_TRUE);
+    }
+#endif
+
+    return done;
+}
+
+// Wait for shader compilation to complete and bind default locations
+// NOTE: Returns the default shader if compiling or linking failed
+Shader FinishShaderLoading(Shader shader)
+{
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    if (shader.id == defaultShader.id) return shader;
+
+    unsigned int shaderIds[2] = { 0 };
+    GLsizei shaderCount = 0;
+    glGetAttachedShaders(shader.id, 2, &shaderCount, shaderIds);
+
+    for (int i = 0; i < shaderCount; i++)
+    {
+        if ((shaderIds[i] == defaultVShaderId) || (shaderIds[i] == defaultFShaderId)) glDetachShader(shader.id, shaderIds[i]);
+        else
+        {
+            CheckShaderCompileStatus(shaderIds[i]);
+            glDetachShader(shader.id, shaderIds[i]);
+            glDeleteShader(shaderIds[i]);
+        }
+    }
+
+    if (CheckShaderProgramLinkStatus(shader.id))
+    {
+        // After shader loading, we TRY to set default location names
+        SetShaderDefaultLocations(&shader);
+    }
+    else
+    {
+        DeleteProgram(shader.id);
+
+        TraceLog(LOG_WARNING, "Custom shader could not be loaded");
+        shader = defaultShader;
+    }
+#endif
+
+    return shader;
+}
+
 // Unload shader from GPU memory (VRAM)
 void UnloadShader(Shader shader)
 {
@@ -3075,7 +3650,9 @@ void SetShaderValue(Shader shader, int uniformLoc, const void *value, int unifor
 void SetShaderValueV(Shader shader, int uniformLoc, const void *value, int uniformType, int count)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
+    UseProgram(shader.id);
+    InvalidateShaderUniforms(shader.id);    // NOTE: The value could replace a cached batch uniform
+    glCallsCount++;
 
     switch (uniformType)
     {
@@ -3100,7 +3677,9 @@ void SetShaderValueV(Shader shader, int uniformLoc, const void *value, int unifo
 void SetShaderValueMatrix(Shader shader, int uniformLoc, Matrix mat)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
+    UseProgram(shader.id);
+    InvalidateShaderUniforms(shader.id);
+    glCallsCount++;
 
     glUniformMatrix4fv(uniformLoc, 1, false, MatrixToFloat(mat));
 
@@ -3112,7 +3691,9 @@ void SetShaderValueMatrix(Shader shader, int uniformLoc, Matrix mat)
 void SetShaderValueTexture(Shader shader, int uniformLoc, Texture2D texture)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
-    glUseProgram(shader.id);
+    UseProgram(shader.id);
+    InvalidateShaderUniforms(shader.id);
+    glCallsCount++;
 
     glUniform1i(uniformLoc, texture.id);
 
@@ -3168,7 +3749,7 @@ Texture2D GenTextureCubemap(Shader shader, Texture2D skyHDR, int size)
     unsigned int fbo, rbo;
     glGenFramebuffers(1, &fbo);
     glGenRenderbuffers(1, &rbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
 #if defined(GRAPHICS_API_OPENGL_33)
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
@@ -3210,14 +3791,14 @@ Texture2D GenTextureCubemap(Shader shader, Texture2D skyHDR, int size)
     };
 
     // Convert HDR equirectangular environment map to cubemap equivalent
-    glUseProgram(shader.id);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, skyHDR.id);
+    UseProgram(shader.id);
+    ActiveTexture(0);
+    BindTexture(skyHDR.id);
     SetShaderValueMatrix(shader, shader.locs[LOC_MATRIX_PROJECTION], fboProjection);
 
     // Note: don't forget to configure the viewport to the capture dimensions
-    glViewport(0, 0, size, size);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    SetViewport(0, 0, size, size);
+    BindFramebuffer(fbo);
 
     for (int i = 0; i < 6; i++)
     {
@@ -3228,10 +3809,10 @@ Texture2D GenTextureCubemap(Shader shader, Texture2D skyHDR, int size)
     }
 
     // Unbind framebuffer and textures
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     // Reset viewport dimensions to default
-    glViewport(0, 0, screenWidth, screenHeight);
+    SetViewport(0, 0, screenWidth, screenHeight);
     //glEnable(GL_CULL_FACE);
 
     // NOTE: Texture2D is a GL_TEXTURE_CUBE_MAP, not a GL_TEXTURE_2D!
@@ -3257,7 +3838,7 @@ Texture2D GenTextureIrradiance(Shader shader, Texture2D cubemap, int size)
     unsigned int fbo, rbo;
     glGenFramebuffers(1, &fbo);
     glGenRenderbuffers(1, &rbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rbo);
@@ -3288,14 +3869,14 @@ Texture2D GenTextureIrradiance(Shader shader, Texture2D cubemap, int size)
     };
 
     // Solve diffuse integral by convolution to create an irradiance cubemap
-    glUseProgram(shader.id);
-    glActiveTexture(GL_TEXTURE0);
+    UseProgram(shader.id);
+    ActiveTexture(0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.id);
     SetShaderValueMatrix(shader, shader.locs[LOC_MATRIX_PROJECTION], fboProjection);
 
     // Note: don't forget to configure the viewport to the capture dimensions
-    glViewport(0, 0, size, size);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    SetViewport(0, 0, size, size);
+    BindFramebuffer(fbo);
 
     for (int i = 0; i < 6; i++)
     {
@@ -3306,10 +3887,10 @@ Texture2D GenTextureIrradiance(Shader shader, Texture2D cubemap, int size)
     }
 
     // Unbind framebuffer and textures
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     // Reset viewport dimensions to default
-    glViewport(0, 0, screenWidth, screenHeight);
+    SetViewport(0, 0, screenWidth, screenHeight);
 
     irradiance.width = size;
     irradiance.height = size;
@@ -3335,7 +3916,7 @@ Texture2D GenTexturePrefilter(Shader shader, Texture2D cubemap, int size)
     unsigned int fbo, rbo;
     glGenFramebuffers(1, &fbo);
     glGenRenderbuffers(1, &rbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rbo);
@@ -3369,12 +3950,12 @@ Texture2D GenTexturePrefilter(Shader shader, Texture2D cubemap, int size)
     };
 
     // Prefilter HDR and store data into mipmap levels
-    glUseProgram(shader.id);
-    glActiveTexture(GL_TEXTURE0);
+    UseProgram(shader.id);
+    ActiveTexture(0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap.id);
     SetShaderValueMatrix(shader, shader.locs[LOC_MATRIX_PROJECTION], fboProjection);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
 
     #define MAX_MIPMAP_LEVELS   5   // Max number of prefilter texture mipmaps
 
@@ -3386,7 +3967,7 @@ Texture2D GenTexturePrefilter(Shader shader, Texture2D cubemap, int size)
 
         glBindRenderbuffer(GL_RENDERBUFFER, rbo);
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, mipWidth, mipHeight);
-        glViewport(0, 0, mipWidth, mipHeight);
+        SetViewport(0, 0, mipWidth, mipHeight);
 
         float roughness = (float)mip/(float)(MAX_MIPMAP_LEVELS - 1);
         glUniform1f(roughnessLoc, roughness);
@@ -3401,10 +3982,10 @@ Texture2D GenTexturePrefilter(Shader shader, Texture2D cubemap, int size)
     }
 
     // Unbind framebuffer and textures
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     // Reset viewport dimensions to default
-    glViewport(0, 0, screenWidth, screenHeight);
+    SetViewport(0, 0, screenWidth, screenHeight);
 
     prefilter.width = size;
     prefilter.height = size;
@@ -3423,7 +4004,7 @@ Texture2D GenTextureBRDF(Shader shader, int size)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     // Generate BRDF convolution texture
     glGenTextures(1, &brdf.id);
-    glBindTexture(GL_TEXTURE_2D, brdf.id);
+    BindTexture(brdf.id);
 #if defined(GRAPHICS_API_OPENGL_33)
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, size, size, 0, GL_RGB, GL_FLOAT, NULL);
 #elif defined(GRAPHICS_API_OPENGL_ES2)
@@ -3439,7 +4020,7 @@ Texture2D GenTextureBRDF(Shader shader, int size)
     unsigned int fbo, rbo;
     glGenFramebuffers(1, &fbo);
     glGenRenderbuffers(1, &rbo);
-    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    BindFramebuffer(fbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
 #if defined(GRAPHICS_API_OPENGL_33)
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
@@ -3448,20 +4029,20 @@ Texture2D GenTextureBRDF(Shader shader, int size)
 #endif
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, brdf.id, 0);
 
-    glViewport(0, 0, size, size);
-    glUseProgram(shader.id);
+    SetViewport(0, 0, size, size);
+    UseProgram(shader.id);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     GenDrawQuad();
 
     // Unbind framebuffer and textures
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BindFramebuffer(0);
 
     // Unload framebuffer but keep color texture
     glDeleteRenderbuffers(1, &rbo);
-    glDeleteFramebuffers(1, &fbo);
+    DeleteFramebuffer(fbo);
 
     // Reset viewport dimensions to default
-    glViewport(0, 0, screenWidth, screenHeight);
+    SetViewport(0, 0, screenWidth, screenHeight);
 
     brdf.width = size;
     brdf.height = size;
@@ -3488,7 +4069,9 @@ void BeginBlendMode(int mode)
         }
 
         blendMode = mode;
+        glCallsCount++;
     }
+    else if (blendMode == mode) glCallsSkipped++;
 }
 
 // End blending mode (reset to default: alpha blending)
@@ -3759,8 +4342,17 @@ static unsigned int CompileShader(const char *shaderStr, int type)
     unsigned int shader = glCreateShader(type);
     glShaderSource(shader, 1, &shaderStr, NULL);
 
-    GLint success = 0;
     glCompileShader(shader);
+    CheckShaderCompileStatus(shader);
+
+    return shader;
+}
+
+// Check shader compile status, log errors
+// NOTE: This waits for the compilation to complete
+static bool CheckShaderCompileStatus(unsigned int shader)
+{
+    GLint success = 0;
     glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
 
     if (success != GL_TRUE)
@@ -3785,7 +4377,7 @@ static unsigned int CompileShader(const char *shaderStr, int type)
     }
     else TraceLog(LOG_INFO, "[SHDR ID %i] Shader compiled successfully", shader);
 
-    return shader;
+    return (success == GL_TRUE);
 }
 
 // Load custom shader strings and return program id
@@ -3795,7 +4387,6 @@ static unsigned int LoadShaderProgram(unsigned int vShaderId, unsigned int fShad
 
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
 
-    GLint success = 0;
     program = glCreateProgram();
 
     glAttachShader(program, vShaderId);
@@ -3815,6 +4406,21 @@ static unsigned int LoadShaderProgram(unsigned int vShaderId, unsigned int fShad
 
     // NOTE: All uniform variables are intitialised to 0 when a program links
 
+    if (!CheckShaderProgramLinkStatus(program))
+    {
+        DeleteProgram(program);
+
+        program = 0;
+    }
+#endif
+    return program;
+}
+
+// Check shader program link status, log errors
+// NOTE: This waits for the linking to complete
+static bool CheckShaderProgramLinkStatus(unsigned int program)
+{
+    GLint success = 0;
     glGetProgramiv(program, GL_LINK_STATUS, &success);
 
     if (success == GL_FALSE)
@@ -3838,13 +4444,10 @@ static unsigned int LoadShaderProgram(unsigned int vShaderId, unsigned int fShad
 #if defined(_MSC_VER)
         RL_FREE(log);
 #endif
-        glDeleteProgram(program);
-
-        program = 0;
     }
     else TraceLog(LOG_INFO, "[SHDR ID %i] Shader program loaded successfully", program);
-#endif
-    return program;
+
+    return (success == GL_TRUE);
 }
 
 
@@ -3980,14 +4583,14 @@ static void SetShaderDefaultLocations(Shader *shader)
 // Unload default shader
 static void UnloadShaderDefault(void)
 {
-    glUseProgram(0);
+    UseProgram(0);
 
     glDetachShader(defaultShader.id, defaultVShaderId);
     glDetachShader(defaultShader.id, defaultFShaderId);
     glDeleteShader(defaultVShaderId);
     glDeleteShader(defaultFShaderId);
 
-    glDeleteProgram(defaultShader.id);
+    DeleteProgram(defaultShader.id);
 }
 
 // Load default internal buffers
@@ -3997,18 +4600,26 @@ static void LoadBuffersDefault(void)
     //--------------------------------------------------------------------------------------------
     for (int i = 0; i < MAX_BATCH_BUFFERING; i++)
     {
+#if defined(SUPPORT_INTERLEAVED_BATCH)
+        vertexData[i].vertices = (float *)RL_CALLOC(4*MAX_BATCH_ELEMENTS, BATCH_VERTEX_SIZE);       // 24 bytes by vertex, 4 vertex by quad
+        vertexData[i].texcoords = vertexData[i].vertices + 3;                                       // Texcoord follows the position
+        vertexData[i].colors = (unsigned char *)(vertexData[i].vertices + 5);                       // Color follows the texcoord
+#else
         vertexData[i].vertices = (float *)RL_MALLOC(sizeof(float)*3*4*MAX_BATCH_ELEMENTS);        // 3 float by vertex, 4 vertex by quad
         vertexData[i].texcoords = (float *)RL_MALLOC(sizeof(float)*2*4*MAX_BATCH_ELEMENTS);       // 2 float by texcoord, 4 texcoord by quad
         vertexData[i].colors = (unsigned char *)RL_MALLOC(sizeof(unsigned char)*4*4*MAX_BATCH_ELEMENTS);  // 4 float by color, 4 colors by quad
+#endif
 #if defined(GRAPHICS_API_OPENGL_33)
         vertexData[i].indices = (unsigned int *)RL_MALLOC(sizeof(unsigned int)*6*MAX_BATCH_ELEMENTS);      // 6 int by quad (indices)
 #elif defined(GRAPHICS_API_OPENGL_ES2)
         vertexData[i].indices = (unsigned short *)RL_MALLOC(sizeof(unsigned short)*6*MAX_BATCH_ELEMENTS);  // 6 int by quad (indices)
 #endif
 
+#if !defined(SUPPORT_INTERLEAVED_BATCH)
         for (int j = 0; j < (3*4*MAX_BATCH_ELEMENTS); j++) vertexData[i].vertices[j] = 0.0f;
         for (int j = 0; j < (2*4*MAX_BATCH_ELEMENTS); j++) vertexData[i].texcoords[j] = 0.0f;
         for (int j = 0; j < (4*4*MAX_BATCH_ELEMENTS); j++) vertexData[i].colors[j] = 0;
+#endif
 
         int k = 0;
 
@@ -4041,30 +4652,44 @@ static void LoadBuffersDefault(void)
         {
             // Initialize Quads VAO
             glGenVertexArrays(1, &vertexData[i].vaoId);
-            glBindVertexArray(vertexData[i].vaoId);
+            BindVertexArray(vertexData[i].vaoId);
         }
 
         // Quads - Vertex buffers binding and attributes enable
+#if defined(SUPPORT_INTERLEAVED_BATCH)
+        // Interleaved vertex buffer: position (shader-location = 0), texcoord (shader-location = 1)
+        // and color (shader-location = 3)
+        glGenBuffers(1, &vertexData[i].vboId[0]);
+        glBindBuffer(GL_ARRAY_BUFFER, vertexData[i].vboId[0]);
+        vertexData[i].mappedVbo[0] = AllocateBufferDefault(&vertexData[i].vboId[0], BATCH_VERTEX_SIZE*4*MAX_BATCH_ELEMENTS, vertexData[i].vertices);
+        glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
+        glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, BATCH_VERTEX_SIZE, 0);
+        glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
+        glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, BATCH_VERTEX_SIZE, (void *)(3*sizeof(float)));
+        glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
+        glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, BATCH_VERTEX_SIZE, (void *)(5*sizeof(float)));
+#else
         // Vertex position buffer (shader-location = 0)
         glGenBuffers(1, &vertexData[i].vboId[0]);
         glBindBuffer(GL_ARRAY_BUFFER, vertexData[i].vboId[0]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*MAX_BATCH_ELEMENTS, vertexData[i].vertices, GL_DYNAMIC_DRAW);
+        vertexData[i].mappedVbo[0] = AllocateBufferDefault(&vertexData[i].vboId[0], sizeof(float)*3*4*MAX_BATCH_ELEMENTS, vertexData[i].vertices);
         glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
         glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
 
         // Vertex texcoord buffer (shader-location = 1)
         glGenBuffers(1, &vertexData[i].vboId[1]);
         glBindBuffer(GL_ARRAY_BUFFER, vertexData[i].vboId[1]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*MAX_BATCH_ELEMENTS, vertexData[i].texcoords, GL_DYNAMIC_DRAW);
+        vertexData[i].mappedVbo[1] = AllocateBufferDefault(&vertexData[i].vboId[1], sizeof(float)*2*4*MAX_BATCH_ELEMENTS, vertexData[i].texcoords);
         glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
         glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, 0, 0);
 
         // Vertex color buffer (shader-location = 3)
         glGenBuffers(1, &vertexData[i].vboId[2]);
         glBindBuffer(GL_ARRAY_BUFFER, vertexData[i].vboId[2]);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(unsigned char)*4*4*MAX_BATCH_ELEMENTS, vertexData[i].colors, GL_DYNAMIC_DRAW);
+        vertexData[i].mappedVbo[2] = AllocateBufferDefault(&vertexData[i].vboId[2], sizeof(unsigned char)*4*4*MAX_BATCH_ELEMENTS, vertexData[i].colors);
         glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
         glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
+#endif
 
         // Fill index buffer
         glGenBuffers(1, &vertexData[i].vboId[3]);
@@ -4079,53 +4704,96 @@ static void LoadBuffersDefault(void)
     TraceLog(LOG_INFO, "Internal buffers uploaded successfully (GPU)");
 
     // Unbind the current VAO
-    if (vaoSupported) glBindVertexArray(0);
+    if (vaoSupported) BindVertexArray(0);
     //--------------------------------------------------------------------------------------------
 }
 
+// Allocate storage for the default vertex buffer bound to GL_ARRAY_BUFFER
+// NOTE: With buffer storage support, the buffer is persistently mapped for writing and the
+// mapping is returned, otherwise the buffer is a regular dynamic one and NULL is returned
+static void *AllocateBufferDefault(unsigned int *vboId, int size, const void *data)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (bufferStorageSupported)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, data, flags);
+        void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+        if (mapped != NULL) return mapped;
+
+        // NOTE: Buffer storage is immutable, glBufferData() can't be used on it (for orphaning),
+        // so the buffer is recreated as a regular one, and so are the rest of the buffers
+        TraceLog(LOG_WARNING, "[VBO ID %i] Persistent buffer mapping failed, using regular dynamic buffers", *vboId);
+        bufferStorageSupported = false;
+        glDeleteBuffers(1, vboId);
+        glGenBuffers(1, vboId);
+        glBindBuffer(GL_ARRAY_BUFFER, *vboId);
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+    return NULL;
+}
+
+// Write vertex data into a default vertex buffer, directly if it's mapped
+// NOTE: Regular buffers are orphaned before updating them: glBufferData() with a NULL pointer
+// gives the buffer new storage, so the update doesn't wait for the GPU to finish its job
+// with the previous data (glBufferSubData() alone may stall)
+static void UpdateBufferDefault(unsigned int vboId, void *mapped, int capacity, int size, const void *data)
+{
+    if (mapped != NULL) memcpy(mapped, data, size);
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vboId);
+        glBufferData(GL_ARRAY_BUFFER, capacity, NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    }
+}
+
 // Update default internal buffers (VAOs/VBOs) with vertex array data
 // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
-// TODO: If no data changed on the CPU arrays --> No need to re-update GPU arrays (change flag required)
+// NOTE: The buffers are used in turns (MAX_BATCH_BUFFERING), so the buffer being written to
+// is usually not the one the GPU is still reading from the previous batch
 static void UpdateBuffersDefault(void)
 {
     // Update vertex buffers data
     if (vertexData[currentBuffer].vCounter > 0)
     {
-        // Activate elements VAO
-        if (vaoSupported) glBindVertexArray(vertexData[currentBuffer].vaoId);
+#if defined(GRAPHICS_API_OPENGL_33)
+        // Persistently mapped buffers are written directly, once the GPU has finished drawing
+        // the last batch that used them (only waits if all the buffers are still in use)
+        if (vertexData[currentBuffer].fence != NULL)
+        {
+            GLenum status = GL_TIMEOUT_EXPIRED;
+            while (status == GL_TIMEOUT_EXPIRED) status = glClientWaitSync(vertexData[currentBuffer].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            glDeleteSync(vertexData[currentBuffer].fence);
+            vertexData[currentBuffer].fence = NULL;
+        }
+#endif
 
+        // Activate elements VAO
+        if (vaoSupported) BindVertexArray(vertexData[currentBuffer].vaoId);
+
+        // NOTE: If mapping failed while the buffers were being allocated, some of them
+        // may be mapped and some not, so each of them is checked separately
+#if defined(SUPPORT_INTERLEAVED_BATCH)
+        // Interleaved vertices buffer
+        UpdateBufferDefault(vertexData[currentBuffer].vboId[0], vertexData[currentBuffer].mappedVbo[0], BATCH_VERTEX_SIZE*4*MAX_BATCH_ELEMENTS,
+                            BATCH_VERTEX_SIZE*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].vertices);
+#else
         // Vertex positions buffer
-        glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[0]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*3*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].vertices);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*3*4*MAX_BATCH_ELEMENTS, vertexData[currentBuffer].vertices, GL_DYNAMIC_DRAW);  // Update all buffer
+        UpdateBufferDefault(vertexData[currentBuffer].vboId[0], vertexData[currentBuffer].mappedVbo[0], sizeof(float)*3*4*MAX_BATCH_ELEMENTS,
+                            sizeof(float)*3*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].vertices);
 
         // Texture coordinates buffer
-        glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[1]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float)*2*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].texcoords);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*2*4*MAX_BATCH_ELEMENTS, vertexData[currentBuffer].texcoords, GL_DYNAMIC_DRAW); // Update all buffer
+        UpdateBufferDefault(vertexData[currentBuffer].vboId[1], vertexData[currentBuffer].mappedVbo[1], sizeof(float)*2*4*MAX_BATCH_ELEMENTS,
+                            sizeof(float)*2*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].texcoords);
 
         // Colors buffer
-        glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[2]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(unsigned char)*4*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].colors);
-        //glBufferData(GL_ARRAY_BUFFER, sizeof(float)*4*4*MAX_BATCH_ELEMENTS, vertexData[currentBuffer].colors, GL_DYNAMIC_DRAW);    // Update all buffer
-
-        // NOTE: glMapBuffer() causes sync issue.
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall) until GPU to finish its job.
-        // To avoid waiting (idle), you can call first glBufferData() with NULL pointer before glMapBuffer().
-        // If you do that, the previous data in PBO will be discarded and glMapBuffer() returns a new
-        // allocated pointer immediately even if GPU is still working with the previous data.
-
-        // Another option: map the buffer object into client's memory
-        // Probably this code could be moved somewhere else...
-        // vertexData[currentBuffer].vertices = (float *)glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
-        // if (vertexData[currentBuffer].vertices)
-        // {
-            // Update vertex data
-        // }
-        // glUnmapBuffer(GL_ARRAY_BUFFER);
+        UpdateBufferDefault(vertexData[currentBuffer].vboId[2], vertexData[currentBuffer].mappedVbo[2], sizeof(unsigned char)*4*4*MAX_BATCH_ELEMENTS,
+                            sizeof(unsigned char)*4*vertexData[currentBuffer].vCounter, vertexData[currentBuffer].colors);
+#endif
 
-        // Unbind the current VAO
-        if (vaoSupported) glBindVertexArray(0);
+        // NOTE: The VAO is left bound, every VAO change in rlgl binds its own VAO first
     }
 }
 
@@ -4150,14 +4818,12 @@ static void DrawBuffersDefault(void)
         if (vertexData[currentBuffer].vCounter > 0)
         {
             // Set current shader and upload current MVP matrix
-            glUseProgram(currentShader.id);
+            UseProgram(currentShader.id);
 
             // Create modelview-projection matrix
             Matrix matMVP = MatrixMultiply(modelview, projection);
 
-            glUniformMatrix4fv(currentShader.locs[LOC_MATRIX_MVP], 1, false, MatrixToFloat(matMVP));
-            glUniform4f(currentShader.locs[LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
-            glUniform1i(currentShader.locs[LOC_MAP_DIFFUSE], 0);    // Provided value refers to the texture unit (active)
+            SetShaderDefaultUniforms(currentShader, matMVP);
 
             // TODO: Support additional texture units on custom shader
             //if (currentShader->locs[LOC_MAP_SPECULAR] > 0) glUniform1i(currentShader.locs[LOC_MAP_SPECULAR], 1);
@@ -4167,9 +4833,19 @@ static void DrawBuffersDefault(void)
 
             int vertexOffset = 0;
 
-            if (vaoSupported) glBindVertexArray(vertexData[currentBuffer].vaoId);
+            if (vaoSupported) BindVertexArray(vertexData[currentBuffer].vaoId);
             else
             {
+#if defined(SUPPORT_INTERLEAVED_BATCH)
+                // Bind vertex attribs: position (shader-location = 0), texcoord (shader-location = 1), color (shader-location = 3)
+                glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[0]);
+                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, BATCH_VERTEX_SIZE, 0);
+                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_POSITION]);
+                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, 0, BATCH_VERTEX_SIZE, (void *)(3*sizeof(float)));
+                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_TEXCOORD01]);
+                glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, BATCH_VERTEX_SIZE, (void *)(5*sizeof(float)));
+                glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
+#else
                 // Bind vertex attrib: position (shader-location = 0)
                 glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[0]);
                 glVertexAttribPointer(currentShader.locs[LOC_VERTEX_POSITION], 3, GL_FLOAT, 0, 0, 0);
@@ -4184,15 +4860,16 @@ static void DrawBuffersDefault(void)
                 glBindBuffer(GL_ARRAY_BUFFER, vertexData[currentBuffer].vboId[2]);
                 glVertexAttribPointer(currentShader.locs[LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, 0, 0);
                 glEnableVertexAttribArray(currentShader.locs[LOC_VERTEX_COLOR]);
+#endif
 
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vertexData[currentBuffer].vboId[3]);
             }
 
-            glActiveTexture(GL_TEXTURE0);
+            ActiveTexture(0);
 
             for (int i = 0; i < drawsCounter; i++)
             {
-                glBindTexture(GL_TEXTURE_2D, draws[i].textureId);
+                BindTexture(draws[i].textureId);
 
                 // TODO: Find some way to bind additional textures --> Use global texture IDs? Register them on draw[i]?
                 //if (currentShader->locs[LOC_MAP_SPECULAR] > 0) { glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, textureUnit1_id); }
@@ -4211,6 +4888,7 @@ static void DrawBuffersDefault(void)
 #endif
                 }
 
+                glCallsCount++;
                 vertexOffset += (draws[i].vertexCount + draws[i].vertexAlignment);
             }
 
@@ -4219,14 +4897,20 @@ static void DrawBuffersDefault(void)
                 glBindBuffer(GL_ARRAY_BUFFER, 0);
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
             }
-
-            glBindTexture(GL_TEXTURE_2D, 0);    // Unbind textures
         }
 
-        if (vaoSupported) glBindVertexArray(0); // Unbind VAO
+        // NOTE: Shader, VAO and texture are left bound, the state cache skips
+        // binding them again on the next flush if they don't change
+    }
 
-        glUseProgram(0);    // Unbind shader program
+#if defined(GRAPHICS_API_OPENGL_33)
+    // Fence the batch, so the mapped buffers are not written again while the GPU is reading them
+    bool mapped = (vertexData[currentBuffer].mappedVbo[0] != NULL) || (vertexData[currentBuffer].mappedVbo[1] != NULL) || (vertexData[currentBuffer].mappedVbo[2] != NULL);
+    if (mapped && (vertexData[currentBuffer].vCounter > 0))
+    {
+        vertexData[currentBuffer].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
+#endif
 
     // Reset vertex counters for next frame
     vertexData[currentBuffer].vCounter = 0;
@@ -4259,7 +4943,7 @@ static void DrawBuffersDefault(void)
 static void UnloadBuffersDefault(void)
 {
     // Unbind everything
-    if (vaoSupported) glBindVertexArray(0);
+    if (vaoSupported) BindVertexArray(0);
     glDisableVertexAttribArray(0);
     glDisableVertexAttribArray(1);
     glDisableVertexAttribArray(2);
@@ -4269,23 +4953,235 @@ static void UnloadBuffersDefault(void)
 
     for (int i = 0; i < MAX_BATCH_BUFFERING; i++)
     {
+#if defined(GRAPHICS_API_OPENGL_33)
+        if (vertexData[i].fence != NULL) glDeleteSync(vertexData[i].fence);
+#endif
+
         // Delete VBOs from GPU (VRAM)
+        // NOTE: Persistently mapped buffers are unmapped when deleted
         glDeleteBuffers(1, &vertexData[i].vboId[0]);
         glDeleteBuffers(1, &vertexData[i].vboId[1]);
         glDeleteBuffers(1, &vertexData[i].vboId[2]);
         glDeleteBuffers(1, &vertexData[i].vboId[3]);
 
         // Delete VAOs from GPU (VRAM)
-        if (vaoSupported) glDeleteVertexArrays(1, &vertexData[i].vaoId);
+        if (vaoSupported) DeleteVertexArray(vertexData[i].vaoId);
 
         // Free vertex arrays memory from CPU (RAM)
+        // NOTE: Interleaved texcoords and colors are part of the vertices array
         RL_FREE(vertexData[i].vertices);
+#if !defined(SUPPORT_INTERLEAVED_BATCH)
         RL_FREE(vertexData[i].texcoords);
         RL_FREE(vertexData[i].colors);
+#endif
         RL_FREE(vertexData[i].indices);
     }
 }
 
+// Load glyph instancing shaders and buffers, and the distance field glyph shaders
+// NOTE: Instancing (and gl_VertexID) requires OpenGL 3.3, other versions draw glyphs as regular quads
+static void LoadGlyphBatch(void)
+{
+    // Distance field glyphs: the atlas alpha holds the distance to the glyph edge (0.5 on the edge),
+    // turned into coverage with a smoothstep about one pixel wide
+    char distanceFieldFShaderStr[] =
+#if defined(GRAPHICS_API_OPENGL_21)
+    "#version 120                       \n"
+#elif defined(GRAPHICS_API_OPENGL_ES2)
+    "#version 100                       \n"
+    "precision mediump float;           \n"     // precision required for OpenGL ES2 (WebGL)
+#endif
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_21)
+    "varying vec2 fragTexCoord;         \n"
+    "varying vec4 fragColor;            \n"
+#elif defined(GRAPHICS_API_OPENGL_33)
+    "#version 330                       \n"
+    "in vec2 fragTexCoord;              \n"
+    "in vec4 fragColor;                 \n"
+    "out vec4 finalColor;               \n"
+#endif
+    "uniform sampler2D texture0;        \n"
+    "uniform vec4 colDiffuse;           \n"
+    "void main()                        \n"
+    "{                                  \n"
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_21)
+    "    float dist = texture2D(texture0, fragTexCoord).a;     \n"
+#elif defined(GRAPHICS_API_OPENGL_33)
+    "    float dist = texture(texture0, fragTexCoord).a;       \n"
+#endif
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    "    float width = 1.0/16.0;        \n"     // NOTE: fwidth() requires an extension on OpenGL ES2
+#else
+    "    float width = max(0.7*fwidth(dist), 0.001); \n"
+#endif
+    "    float alpha = smoothstep(0.5 - width, 0.5 + width, dist); \n"
+    "    vec4 color = colDiffuse*fragColor; \n"
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_21)
+    "    gl_FragColor = vec4(color.rgb, color.a*alpha); \n"
+#elif defined(GRAPHICS_API_OPENGL_33)
+    "    finalColor = vec4(color.rgb, color.a*alpha);   \n"
+#endif
+    "}                                  \n";
+
+    distanceFieldFShaderId = CompileShader(distanceFieldFShaderStr, GL_FRAGMENT_SHADER);
+
+    // Distance field shader for the default internal buffers (used when instancing is not supported)
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++) distanceFieldShader.locs[i] = -1;
+    if (distanceFieldFShaderId != 0) distanceFieldShader.id = LoadShaderProgram(defaultVShaderId, distanceFieldFShaderId);
+
+    if (distanceFieldShader.id > 0)
+    {
+        distanceFieldShader.locs[LOC_VERTEX_POSITION] = glGetAttribLocation(distanceFieldShader.id, "vertexPosition");
+        distanceFieldShader.locs[LOC_VERTEX_TEXCOORD01] = glGetAttribLocation(distanceFieldShader.id, "vertexTexCoord");
+        distanceFieldShader.locs[LOC_VERTEX_COLOR] = glGetAttribLocation(distanceFieldShader.id, "vertexColor");
+        distanceFieldShader.locs[LOC_MATRIX_MVP] = glGetUniformLocation(distanceFieldShader.id, "mvp");
+        distanceFieldShader.locs[LOC_COLOR_DIFFUSE] = glGetUniformLocation(distanceFieldShader.id, "colDiffuse");
+        distanceFieldShader.locs[LOC_MAP_DIFFUSE] = glGetUniformLocation(distanceFieldShader.id, "texture0");
+    }
+    else TraceLog(LOG_WARNING, "Distance field glyph shader could not be loaded");
+
+#if defined(GRAPHICS_API_OPENGL_33) && !defined(GRAPHICS_API_OPENGL_21)
+    // Every instance is a triangle strip quad, its corners are picked by the vertex id
+    // NOTE: Attribute locations are fixed, so the same VAO works with both glyph shaders
+    char glyphVShaderStr[] =
+    "#version 330                       \n"
+    "layout(location = 0) in vec4 glyphDest;   \n"
+    "layout(location = 1) in vec4 glyphSource; \n"
+    "layout(location = 2) in vec4 glyphColor;  \n"
+    "out vec2 fragTexCoord;             \n"
+    "out vec4 fragColor;                \n"
+    "uniform mat4 mvp;                  \n"
+    "void main()                        \n"
+    "{                                  \n"
+    "    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1)); \n"
+    "    fragTexCoord = mix(glyphSource.xy, glyphSource.zw, corner); \n"
+    "    fragColor = glyphColor;        \n"
+    "    gl_Position = mvp*vec4(glyphDest.xy + corner*glyphDest.zw, 0.0, 1.0); \n"
+    "}                                  \n";
+
+    for (int i = 0; i < MAX_SHADER_LOCATIONS; i++)
+    {
+        glyphShader.locs[i] = -1;
+        glyphDistanceFieldShader.locs[i] = -1;
+    }
+
+    // NOTE: The fragment shaders are shared with the default and distance field shaders
+    unsigned int glyphVShaderId = CompileShader(glyphVShaderStr, GL_VERTEX_SHADER);
+    if (glyphVShaderId != 0)
+    {
+        glyphShader.id = LoadShaderProgram(glyphVShaderId, defaultFShaderId);
+        if (distanceFieldFShaderId != 0) glyphDistanceFieldShader.id = LoadShaderProgram(glyphVShaderId, distanceFieldFShaderId);
+        glDeleteShader(glyphVShaderId);     // NOTE: Only flagged for deletion, the programs keep it
+    }
+
+    if ((glyphShader.id == 0) || (glyphDistanceFieldShader.id == 0))
+    {
+        TraceLog(LOG_WARNING, "Glyph instancing shaders could not be loaded, glyphs drawn as quads");
+        return;
+    }
+
+    Shader *shaders[2] = { &glyphShader, &glyphDistanceFieldShader };
+    for (int i = 0; i < 2; i++)
+    {
+        shaders[i]->locs[LOC_MATRIX_MVP] = glGetUniformLocation(shaders[i]->id, "mvp");
+        shaders[i]->locs[LOC_COLOR_DIFFUSE] = glGetUniformLocation(shaders[i]->id, "colDiffuse");
+        shaders[i]->locs[LOC_MAP_DIFFUSE] = glGetUniformLocation(shaders[i]->id, "texture0");
+    }
+
+    glyphInstances = (GlyphInstance *)RL_MALLOC(sizeof(GlyphInstance)*MAX_GLYPH_INSTANCES);
+
+    glGenVertexArrays(1, &glyphVaoId);
+    BindVertexArray(glyphVaoId);
+
+    glGenBuffers(1, &glyphVboId);
+    glBindBuffer(GL_ARRAY_BUFFER, glyphVboId);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GlyphInstance)*MAX_GLYPH_INSTANCES, NULL, GL_DYNAMIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, 0, sizeof(GlyphInstance), (void *)0);
+    glVertexAttribDivisor(0, 1);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, 0, sizeof(GlyphInstance), (void *)(4*sizeof(float)));
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(GlyphInstance), (void *)(8*sizeof(float)));
+    glVertexAttribDivisor(2, 1);
+
+    BindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glyphInstancingSupported = true;
+    TraceLog(LOG_INFO, "[SHDR ID %i] Glyph instancing shader loaded successfully", glyphShader.id);
+#endif
+}
+
+// Draw the queued glyph instances with one instanced draw call
+static void DrawGlyphBatch(void)
+{
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (glyphCount == 0) return;
+
+    // NOTE: The buffer is orphaned first, so the update doesn't wait for the previous draw
+    glBindBuffer(GL_ARRAY_BUFFER, glyphVboId);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GlyphInstance)*MAX_GLYPH_INSTANCES, NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(GlyphInstance)*glyphCount, glyphInstances);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    Shader shader = glyphDistanceField? glyphDistanceFieldShader : glyphShader;
+    Matrix matMVP = MatrixMultiply(modelview, projection);
+
+    UseProgram(shader.id);
+    SetShaderDefaultUniforms(shader, matMVP);
+
+    ActiveTexture(0);
+    BindTexture(glyphTextureId);
+
+    BindVertexArray(glyphVaoId);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, glyphCount);
+    glCallsCount++;
+
+    glyphCount = 0;
+#endif
+}
+
+// Unload glyph instancing and distance field shaders and buffers
+static void UnloadGlyphBatch(void)
+{
+    if (distanceFieldShader.id > 0)
+    {
+        glDetachShader(distanceFieldShader.id, defaultVShaderId);
+        DeleteProgram(distanceFieldShader.id);
+        distanceFieldShader.id = 0;
+    }
+
+#if defined(GRAPHICS_API_OPENGL_33)
+    if (glyphShader.id > 0)
+    {
+        glDetachShader(glyphShader.id, defaultFShaderId);
+        DeleteProgram(glyphShader.id);
+        glyphShader.id = 0;
+    }
+    if (glyphDistanceFieldShader.id > 0)
+    {
+        DeleteProgram(glyphDistanceFieldShader.id);
+        glyphDistanceFieldShader.id = 0;
+    }
+
+    if (glyphInstancingSupported)
+    {
+        glDeleteBuffers(1, &glyphVboId);
+        DeleteVertexArray(glyphVaoId);
+        RL_FREE(glyphInstances);
+    }
+
+    glyphInstancingSupported = false;
+    glyphCount = 0;
+#endif
+
+    if (distanceFieldFShaderId != 0) glDeleteShader(distanceFieldFShaderId);
+    distanceFieldFShaderId = 0;
+}
+
 // Renders a 1x1 XY quad in NDC
 static void GenDrawQuad(void)
 {
@@ -4303,7 +5199,7 @@ static void GenDrawQuad(void)
     // Set up plane VAO
     glGenVertexArrays(1, &quadVAO);
     glGenBuffers(1, &quadVBO);
-    glBindVertexArray(quadVAO);
+    BindVertexArray(quadVAO);
 
     // Fill buffer
     glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
@@ -4316,12 +5212,13 @@ static void GenDrawQuad(void)
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5*sizeof(float), (void *)(3*sizeof(float)));
 
     // Draw quad
-    glBindVertexArray(quadVAO);
+    BindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
+    glCallsCount++;
+    BindVertexArray(0);
 
     glDeleteBuffers(1, &quadVBO);
-    glDeleteVertexArrays(1, &quadVAO);
+    DeleteVertexArray(quadVAO);
 }
 
 // Renders a 1x1 3D cube in NDC
@@ -4378,7 +5275,7 @@ static void GenDrawCube(void)
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
     // Link vertex attributes
-    glBindVertexArray(cubeVAO);
+    BindVertexArray(cubeVAO);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)0);
     glEnableVertexAttribArray(1);
@@ -4386,15 +5283,16 @@ static void GenDrawCube(void)
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8*sizeof(float), (void *)(6*sizeof(float)));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    BindVertexArray(0);
 
     // Draw cube
-    glBindVertexArray(cubeVAO);
+    BindVertexArray(cubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    glCallsCount++;
+    BindVertexArray(0);
 
     glDeleteBuffers(1, &cubeVBO);
-    glDeleteVertexArrays(1, &cubeVAO);
+    DeleteVertexArray(cubeVAO);
 }
 
 #if defined(SUPPORT_VR_SIMULATOR)
@@ -4418,8 +5316,201 @@ static void SetStereoView(int eye, Matrix matProjection, Matrix matModelView)
 }
 #endif  // SUPPORT_VR_SIMULATOR
 
+// Use shader program, skipped if already in use
+static void UseProgram(unsigned int id)
+{
+    if (glState.program == id) glCallsSkipped++;
+    else
+    {
+        glUseProgram(id);
+        glState.program = id;
+        glCallsCount++;
+    }
+}
+
+// Bind vertex array object, skipped if already bound
+// NOTE: Requires VAO support (vaoSupported)
+static void BindVertexArray(unsigned int id)
+{
+    if (glState.vertexArray == id) glCallsSkipped++;
+    else
+    {
+        glBindVertexArray(id);
+        glState.vertexArray = id;
+        glCallsCount++;
+    }
+}
+
+// Activate texture unit, skipped if already active
+static void ActiveTexture(int unit)
+{
+    if (glState.activeTexture == unit) glCallsSkipped++;
+    else
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glState.activeTexture = unit;
+        glCallsCount++;
+    }
+}
+
+// Bind framebuffer (0 is the default framebuffer), skipped if already bound
+static void BindFramebuffer(unsigned int id)
+{
+    if (glState.framebuffer == id) glCallsSkipped++;
+    else
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, id);
+        glState.framebuffer = id;
+        glCallsCount++;
+    }
+}
+
+// Delete shader program
+// NOTE: A program in use is only deleted once it stops being used, so it's bound again next time
+static void DeleteProgram(unsigned int id)
+{
+    glDeleteProgram(id);
+
+    if (glState.program == id) glState.program = STATE_UNKNOWN;
+
+    for (int i = 0; i < MAX_STATE_SHADERS; i++)
+    {
+        if (shaderUniforms[i].id == id) shaderUniforms[i].id = 0;
+    }
+}
+
+// Delete framebuffer, deleting the bound framebuffer binds the default one
+static void DeleteFramebuffer(unsigned int id)
+{
+    glDeleteFramebuffers(1, &id);
+
+    if (glState.framebuffer == id) glState.framebuffer = 0;
+}
+
+// Delete vertex array object, deleting the bound VAO binds 0
+static void DeleteVertexArray(unsigned int id)
+{
+    glDeleteVertexArrays(1, &id);
+
+    if (glState.vertexArray == id) glState.vertexArray = 0;
+}
+
+// Upload the uniforms every batch draw sets: mvp, colDiffuse and texture0
+// NOTE: colDiffuse and texture0 never change (white, unit 0), so once a program
+// has them only the MVP matrix is uploaded again, and only when it changes
+static void SetShaderDefaultUniforms(Shader shader, Matrix mvp)
+{
+    ShaderUniformState *state = NULL;
+
+    for (int i = 0; i < MAX_STATE_SHADERS; i++)
+    {
+        if (shaderUniforms[i].id == shader.id)
+        {
+            state = &shaderUniforms[i];
+            break;
+        }
+    }
+
+    if (state == NULL)
+    {
+        state = &shaderUniforms[shaderUniformsNext];
+        shaderUniformsNext = (shaderUniformsNext + 1)%MAX_STATE_SHADERS;
+
+        state->id = shader.id;
+        state->valid = false;
+    }
+
+    if (!state->valid)
+    {
+        glUniform4f(shader.locs[LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
+        glUniform1i(shader.locs[LOC_MAP_DIFFUSE], 0);    // Provided value refers to the texture unit (active)
+        glCallsCount += 2;
+    }
+    else glCallsSkipped += 2;
+
+    if (!state->valid || (memcmp(&state->mvp, &mvp, sizeof(Matrix)) != 0))
+    {
+        glUniformMatrix4fv(shader.locs[LOC_MATRIX_MVP], 1, false, MatrixToFloat(mvp));
+        state->mvp = mvp;
+        glCallsCount++;
+    }
+    else glCallsSkipped++;
+
+    state->valid = true;
+}
+
+// Forget the batch uniforms cached for a shader program, they are uploaded on its next batch draw
+static void InvalidateShaderUniforms(unsigned int id)
+{
+    for (int i = 0; i < MAX_STATE_SHADERS; i++)
+    {
+        if (shaderUniforms[i].id == id) shaderUniforms[i].valid = false;
+    }
+}
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
+// Forget all cached GL state, the next change of every binding is issued
+static void ResetStateCache(void)
+{
+    glState.program = STATE_UNKNOWN;
+    glState.vertexArray = STATE_UNKNOWN;
+#if defined(GRAPHICS_API_OPENGL_11)
+    glState.activeTexture = 0;      // Only the first texture unit is used
+#else
+    glState.activeTexture = -1;
+#endif
+    for (int i = 0; i < MAX_STATE_TEXTURE_UNITS; i++) glState.textures[i] = STATE_UNKNOWN;
+    glState.framebuffer = STATE_UNKNOWN;
+    for (int i = 0; i < 4; i++) glState.viewport[i] = -1;
+
+#if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    memset(shaderUniforms, 0, sizeof(shaderUniforms));
+    shaderUniformsNext = 0;
+#endif
+}
+
+// Bind 2D texture to the active texture unit, skipped if already bound there
+static void BindTexture(unsigned int id)
+{
+    int unit = glState.activeTexture;
+    bool cached = (unit >= 0) && (unit < MAX_STATE_TEXTURE_UNITS);
+
+    if (cached && (glState.textures[unit] == id)) glCallsSkipped++;
+    else
+    {
+        glBindTexture(GL_TEXTURE_2D, id);
+        if (cached) glState.textures[unit] = id;
+        glCallsCount++;
+    }
+}
+
+// Delete texture, deleting a bound texture binds 0 on its texture units
+static void DeleteTexture(unsigned int id)
+{
+    glDeleteTextures(1, &id);
+
+    for (int i = 0; i < MAX_STATE_TEXTURE_UNITS; i++)
+    {
+        if (glState.textures[i] == id) glState.textures[i] = 0;
+    }
+}
+
+// Set viewport area, skipped if unchanged
+static void SetViewport(int x, int y, int width, int height)
+{
+    if ((glState.viewport[0] == x) && (glState.viewport[1] == y) &&
+        (glState.viewport[2] == width) && (glState.viewport[3] == height)) glCallsSkipped++;
+    else
+    {
+        glViewport(x, y, width, height);
+        glState.viewport[0] = x;
+        glState.viewport[1] = y;
+        glState.viewport[2] = width;
+        glState.viewport[3] = height;
+        glCallsCount++;
+    }
+}
+
 #if defined(GRAPHICS_API_OPENGL_11)
 // Mipmaps data is generated after image data
 // NOTE: Only works with RGBA (4 bytes) data!
@@ -16,7 +16,9 @@
  */
 
 /* This file contains the script that is displayed to the player
- * during the game. */
+ * during the game. The game doesn't include it: the build scripts
+ * compile it into metro_assets/script.bin with tools/compile_script.c,
+ * and the game reads that. */
 
 #ifndef NARRATOR_SCRIPT_H
 #define NARRATOR_SCRIPT_H
@@ -24,6 +26,14 @@
 #define COMMENTS_COUNT 13
 #define COMMENT_LINES 8
 
+// The comments are spread evenly over the walk to Lauttasaari, starting a
+// few meters in, and each line is shown for a distance based on its length
+#define SCRIPT_DISTANCE 2140.0f
+#define COMMENT_START 6.0f
+#define COMMENT_LENGTH (SCRIPT_DISTANCE / COMMENTS_COUNT)
+#define LONGEST_COMMENT_CHARACTER_COUNT_ESTIMATE 400
+#define METERS_PER_CHARACTER (SCRIPT_DISTANCE / (COMMENTS_COUNT * LONGEST_COMMENT_CHARACTER_COUNT_ESTIMATE))
+
 const char *narratorComments[COMMENTS_COUNT][COMMENT_LINES] = {
     {"This is a metro tunnel under Helsinki,",
      "or more specifically, the Ruoholahti station.",
@@ -0,0 +1,280 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdf_shader.h"
+#include "render_utils.h"
+#include "rlgl.h"
+
+// How many frames are rendered when timing the shader in development mode
+#define TIMING_SAMPLE_FRAMES 30
+// The size of the target the shader is timed on in development mode
+#define TIMING_TARGET_WIDTH 960
+#define TIMING_TARGET_HEIGHT 480
+// The uniform buffer binding point of the SDFParameters block
+#define SDF_PARAMETERS_BINDING 0
+
+// Uploads one of the parameters, or with uniform buffers, marks them
+// to be uploaded all at once before the next draw
+static void UploadSDFShaderValue(SDFShader *sdfShader, int location,
+                                 const void *value, int uniformType) {
+    if (sdfShader->loading) {
+        return;
+    }
+    if (sdfShader->parameterBuffer != 0) {
+        sdfShader->parametersChanged = true;
+    } else {
+        SetShaderValue(sdfShader->shader, location, value, uniformType);
+    }
+}
+
+static void ApplySDFShaderParameters(SDFShader *sdfShader) {
+    SDFParameters *parameters = &sdfShader->parameters;
+    UploadSDFShaderValue(sdfShader, sdfShader->resolutionLocation,
+                         parameters->resolution, UNIFORM_VEC2);
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraPositionLocation,
+                         parameters->cameraPosition, UNIFORM_VEC3);
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraRotationLocation,
+                         parameters->cameraRotation, UNIFORM_VEC3);
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraFieldOfViewLocation,
+                         &parameters->cameraFieldOfView, UNIFORM_FLOAT);
+    UploadSDFShaderValue(sdfShader, sdfShader->stageLocation,
+                         &parameters->stage, UNIFORM_INT);
+    UploadSDFShaderValue(sdfShader, sdfShader->maxDistanceLocation,
+                         &parameters->maxDistance, UNIFORM_FLOAT);
+    UploadSDFShaderValue(sdfShader, sdfShader->foveatedLocation,
+                         &parameters->foveated, UNIFORM_INT);
+}
+
+SDFShader LoadSDFShader(const char *path) {
+    SDFShader sdfShader = LoadSDFShaderAsync(path);
+    FinishLoadingSDFShader(&sdfShader);
+    return sdfShader;
+}
+
+// Starts compiling the shader without waiting for it. The setters can
+// be used right away, but the shader needs to be polled with
+// IsSDFShaderLoaded (or waited for with FinishLoadingSDFShader) before
+// drawing with it.
+SDFShader LoadSDFShaderAsync(const char *path) {
+    SDFShader sdfShader = { 0 };
+    // Same as the default in the plain uniform version of sdf.glsl
+    sdfShader.parameters.maxDistance = 100.0f;
+    if (rlGetVersion() == OPENGL_11) {
+        printf("ERROR: OpenGL 1.1 is not supported.\n");
+        sdfShader.shader = LoadShader(0, 0);
+    } else {
+        sdfShader.shader = LoadVersionedShaderAsync(path);
+        sdfShader.loading = true;
+    }
+    return sdfShader;
+}
+
+bool IsSDFShaderLoaded(SDFShader *sdfShader) {
+    if (sdfShader->loading && IsShaderLoadingDone(sdfShader->shader)) {
+        FinishLoadingSDFShader(sdfShader);
+    }
+    return !sdfShader->loading;
+}
+
+void FinishLoadingSDFShader(SDFShader *sdfShader) {
+    if (sdfShader->loading) {
+        sdfShader->shader = FinishShaderLoading(sdfShader->shader);
+        sdfShader->loading = false;
+    }
+
+    // The parameters are in a uniform block with GLSL 330, other
+    // versions (and the default shader, if loading failed) don't have it
+    Shader shader = sdfShader->shader;
+    if (sdfShader->parameterBuffer == 0) {
+        sdfShader->parameterBuffer = rlLoadUniformBuffer(sizeof(SDFParameters));
+    }
+    if (!rlSetShaderUniformBlock(shader, "SDFParameters",
+                                 sdfShader->parameterBuffer,
+                                 SDF_PARAMETERS_BINDING)) {
+        rlUnloadUniformBuffer(sdfShader->parameterBuffer);
+        sdfShader->parameterBuffer = 0;
+    }
+
+    sdfShader->resolutionLocation = GetShaderLocation(shader, "resolution");
+    sdfShader->cameraPositionLocation = GetShaderLocation(shader, "cameraPosition");
+    sdfShader->cameraRotationLocation = GetShaderLocation(shader, "cameraRotation");
+    sdfShader->cameraFieldOfViewLocation = GetShaderLocation(shader, "cameraFieldOfView");
+    sdfShader->stageLocation = GetShaderLocation(shader, "stage");
+    sdfShader->maxDistanceLocation = GetShaderLocation(shader, "maxDistance");
+    sdfShader->foveatedLocation = GetShaderLocation(shader, "foveated");
+    ApplySDFShaderParameters(sdfShader);
+}
+
+void UnloadSDFShader(SDFShader sdfShader) {
+    rlUnloadUniformBuffer(sdfShader.parameterBuffer);
+    // Failed loads fall back to the default shader, which isn't ours to unload
+    if (sdfShader.shader.id != GetShaderDefault().id) {
+        UnloadShader(sdfShader.shader);
+    }
+}
+
+void SetSDFShaderResolution(SDFShader *sdfShader, int width, int height) {
+    sdfShader->parameters.resolution[0] = (float)width;
+    sdfShader->parameters.resolution[1] = (float)height;
+    UploadSDFShaderValue(sdfShader, sdfShader->resolutionLocation,
+                         sdfShader->parameters.resolution, UNIFORM_VEC2);
+}
+
+void SetSDFShaderMaxDistance(SDFShader *sdfShader, float maxDistance) {
+    sdfShader->parameters.maxDistance = maxDistance;
+    UploadSDFShaderValue(sdfShader, sdfShader->maxDistanceLocation,
+                         &sdfShader->parameters.maxDistance, UNIFORM_FLOAT);
+}
+
+void SetSDFShaderFoveated(SDFShader *sdfShader, bool foveated) {
+    sdfShader->parameters.foveated = foveated;
+    UploadSDFShaderValue(sdfShader, sdfShader->foveatedLocation,
+                         &sdfShader->parameters.foveated, UNIFORM_INT);
+}
+
+void SetSDFShaderCamera(SDFShader *sdfShader, float *position, float *rotation,
+                        float fieldOfView, int stage) {
+    // The shader is needed from here on, so wait for it if it isn't done
+    if (sdfShader->loading) {
+        FinishLoadingSDFShader(sdfShader);
+    }
+
+    // A camera that stands still doesn't need uploading at all
+    SDFParameters *parameters = &sdfShader->parameters;
+    if (memcmp(parameters->cameraPosition, position, 3 * sizeof(float)) == 0 &&
+        memcmp(parameters->cameraRotation, rotation, 3 * sizeof(float)) == 0 &&
+        parameters->cameraFieldOfView == fieldOfView &&
+        parameters->stage == stage) {
+        return;
+    }
+    memcpy(parameters->cameraPosition, position, 3 * sizeof(float));
+    memcpy(parameters->cameraRotation, rotation, 3 * sizeof(float));
+    parameters->cameraFieldOfView = fieldOfView;
+    parameters->stage = stage;
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraPositionLocation,
+                         parameters->cameraPosition, UNIFORM_VEC3);
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraRotationLocation,
+                         parameters->cameraRotation, UNIFORM_VEC3);
+    UploadSDFShaderValue(sdfShader, sdfShader->cameraFieldOfViewLocation,
+                         &parameters->cameraFieldOfView, UNIFORM_FLOAT);
+    UploadSDFShaderValue(sdfShader, sdfShader->stageLocation,
+                         &parameters->stage, UNIFORM_INT);
+}
+
+void DrawSDFShader(SDFShader *sdfShader, RenderTexture2D target) {
+    if (sdfShader->parametersChanged) {
+        rlUpdateUniformBuffer(sdfShader->parameterBuffer,
+                              &sdfShader->parameters, sizeof(SDFParameters));
+        sdfShader->parametersChanged = false;
+    }
+    BeginTextureMode(target);
+    BeginShaderMode(sdfShader->shader);
+    DrawRectangle(0, 0, target.texture.width, target.texture.height,
+                  (Color){0xFF, 0x00, 0xFF, 0xFF});
+    EndShaderMode();
+    EndTextureMode();
+}
+
+static void WaitForRender(RenderTexture2D target) {
+    // The pixels can't be read back before the rendering is done
+    void *pixels = rlReadTexturePixels(target.texture);
+    free(pixels);
+}
+
+float MeasureSDFShader(SDFShader *sdfShader, RenderTexture2D target) {
+    // A fixed view a bit into the tunnel, with the noise, the lights
+    // and the rails all in sight
+    float position[] = { 0.0f, 1.75f, 300.0f };
+    float rotation[] = { 10.0f, 0.0f, 0.0f };
+    SetSDFShaderCamera(sdfShader, position, rotation, 80.0f, 33);
+
+    // The first frame is left out, drivers tend to do some of their
+    // compilation work lazily on the first draw
+    DrawSDFShader(sdfShader, target);
+    WaitForRender(target);
+
+    double startTime = GetTime();
+    for (int i = 0; i < TIMING_SAMPLE_FRAMES; i++) {
+        DrawSDFShader(sdfShader, target);
+    }
+    WaitForRender(target);
+    return (float)((GetTime() - startTime) * 1000.0 / TIMING_SAMPLE_FRAMES);
+}
+
+static
+float MeasureWatchedSDFShader(SDFShaderWatch *watch, SDFShader *sdfShader) {
+    // The game's resolution and foveation are put back after timing
+    float width = sdfShader->parameters.resolution[0];
+    float height = sdfShader->parameters.resolution[1];
+    bool foveated = sdfShader->parameters.foveated;
+    SetSDFShaderResolution(sdfShader, TIMING_TARGET_WIDTH,
+                           TIMING_TARGET_HEIGHT);
+    SetSDFShaderFoveated(sdfShader, false);
+    float frameTime = MeasureSDFShader(sdfShader, watch->target);
+    SetSDFShaderResolution(sdfShader, (int)width, (int)height);
+    SetSDFShaderFoveated(sdfShader, foveated);
+    return frameTime;
+}
+
+SDFShaderWatch WatchSDFShader(const char *path, SDFShader *sdfShader) {
+    SDFShaderWatch watch = { 0 };
+    watch.path = path;
+    watch.modTime = GetFileModTime(path);
+    watch.target = LoadRenderTexture(TIMING_TARGET_WIDTH,
+                                     TIMING_TARGET_HEIGHT);
+    watch.frameTime = MeasureWatchedSDFShader(&watch, sdfShader);
+    printf("INFO: Watching %s for changes, currently %.2f ms per frame.\n",
+           path, watch.frameTime);
+    return watch;
+}
+
+void ReloadChangedSDFShader(SDFShaderWatch *watch, SDFShader *sdfShader) {
+    long modTime = GetFileModTime(watch->path);
+    if (modTime == watch->modTime) {
+        return;
+    }
+    watch->modTime = modTime;
+
+    SDFShader reloaded = LoadSDFShader(watch->path);
+    if (reloaded.shader.id == GetShaderDefault().id) {
+        printf("WARNING: %s could not be compiled, keeping the old version.\n",
+               watch->path);
+        return;
+    }
+    reloaded.parameters = sdfShader->parameters;
+    ApplySDFShaderParameters(&reloaded);
+    UnloadSDFShader(*sdfShader);
+    *sdfShader = reloaded;
+
+    float frameTime = MeasureWatchedSDFShader(watch, sdfShader);
+    float difference = frameTime - watch->frameTime;
+    printf("INFO: Reloaded %s, %.2f ms per frame (%+.2f ms, %+.1f%%).\n",
+           watch->path, frameTime, difference,
+           difference / watch->frameTime * 100.0f);
+    watch->frameTime = frameTime;
+}
+
+void UnwatchSDFShader(SDFShaderWatch *watch) {
+    if (watch->target.id != 0) {
+        UnloadRenderTexture(watch->target);
+        watch->target = (RenderTexture2D){ 0 };
+    }
+}
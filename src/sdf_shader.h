@@ -0,0 +1,87 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SDF_SHADER_H
+#define SDF_SHADER_H
+
+#include "raylib.h"
+
+// The parameters of the shader, laid out like the std140 uniform block
+// of the same name in sdf.glsl. New fields go into the same places in
+// both, with the padding std140 requires.
+typedef struct {
+    float resolution[2];
+    float padding0[2];
+    float cameraPosition[3];
+    float cameraFieldOfView;
+    float cameraRotation[3];
+    int stage;
+    float maxDistance;
+    int foveated;
+    float padding1[2];
+} SDFParameters;
+
+typedef struct {
+    Shader shader;
+    int resolutionLocation;
+    int cameraPositionLocation;
+    int cameraRotationLocation;
+    int cameraFieldOfViewLocation;
+    int stageLocation;
+    int maxDistanceLocation;
+    int foveatedLocation;
+
+    // The current values of the uniforms, kept so they can be uploaded
+    // after loading or reloading the shader. When uniform buffers are
+    // supported, they're uploaded from here all at once, only after
+    // something has changed.
+    SDFParameters parameters;
+    unsigned int parameterBuffer;
+    bool parametersChanged;
+
+    // Set while the driver is still compiling the shader, the uniforms
+    // are uploaded once it's done
+    bool loading;
+} SDFShader;
+
+typedef struct {
+    const char *path;
+    long modTime;
+    // The versions are timed on this fixed size target without
+    // foveation, so the game's render scale and foveation settings don't
+    // change the comparison between them
+    RenderTexture2D target;
+    float frameTime;
+} SDFShaderWatch;
+
+SDFShader LoadSDFShader(const char *path);
+SDFShader LoadSDFShaderAsync(const char *path);
+bool IsSDFShaderLoaded(SDFShader *sdfShader);
+void FinishLoadingSDFShader(SDFShader *sdfShader);
+void UnloadSDFShader(SDFShader sdfShader);
+void SetSDFShaderResolution(SDFShader *sdfShader, int width, int height);
+void SetSDFShaderMaxDistance(SDFShader *sdfShader, float maxDistance);
+void SetSDFShaderFoveated(SDFShader *sdfShader, bool foveated);
+void SetSDFShaderCamera(SDFShader *sdfShader, float *position, float *rotation,
+                        float fieldOfView, int stage);
+void DrawSDFShader(SDFShader *sdfShader, RenderTexture2D target);
+float MeasureSDFShader(SDFShader *sdfShader, RenderTexture2D target);
+SDFShaderWatch WatchSDFShader(const char *path, SDFShader *sdfShader);
+void ReloadChangedSDFShader(SDFShaderWatch *watch, SDFShader *sdfShader);
+void UnwatchSDFShader(SDFShaderWatch *watch);
+
+#endif
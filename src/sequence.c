@@ -0,0 +1,219 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sequence.h"
+#include "thread.h"
+
+// How long the threads sleep while waiting for each other
+#define WRITER_POLL_INTERVAL 0.001
+
+struct SequenceWriter {
+    const char *output;
+    // Only used for the raw output, PNGs are opened per frame
+    FILE *rawFile;
+    Thread *thread;
+    volatile long running;
+
+    // The frame handed over to the writer thread, owned by the writer
+    // thread while framePending is set
+    Image frame;
+    int frameIndex;
+    volatile long framePending;
+    // Set when a frame couldn't be written, no more frames are taken
+    volatile long failed;
+};
+
+static
+float CatmullRom(float p0, float p1, float p2, float p3, float t) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return 0.5f * (2.0f * p1 + (p2 - p0) * t +
+                   (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+                   (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+CameraKeyframe GetCameraSplinePoint(const CameraKeyframe *keyframes,
+                                    int keyframeCount, float t) {
+    if (keyframeCount == 1) {
+        return keyframes[0];
+    }
+
+    float position = t * (keyframeCount - 1);
+    int segment = (int)position;
+    if (segment < 0) {
+        segment = 0;
+    } else if (segment > keyframeCount - 2) {
+        segment = keyframeCount - 2;
+    }
+    float segmentT = position - segment;
+
+    // The ends are repeated, so the spline goes through them too
+    const CameraKeyframe *k0 = &keyframes[segment > 0 ? segment - 1 : 0];
+    const CameraKeyframe *k1 = &keyframes[segment];
+    const CameraKeyframe *k2 = &keyframes[segment + 1];
+    const CameraKeyframe *k3 =
+        &keyframes[segment + 2 < keyframeCount ? segment + 2 : segment + 1];
+    CameraKeyframe result;
+    for (int i = 0; i < 3; i++) {
+        result.position[i] = CatmullRom(k0->position[i], k1->position[i],
+                                        k2->position[i], k3->position[i],
+                                        segmentT);
+        result.rotation[i] = CatmullRom(k0->rotation[i], k1->rotation[i],
+                                        k2->rotation[i], k3->rotation[i],
+                                        segmentT);
+    }
+    return result;
+}
+
+// Returns the amount of integer conversions (like "%05d") in format, or
+// -1 if it has any other conversions, which would read arguments that
+// WriteFrame doesn't pass. "%%" is allowed, as it doesn't read any.
+static
+int CountIntegerConversions(const char *format) {
+    int count = 0;
+    for (const char *c = format; *c != '\0'; c++) {
+        if (*c != '%') {
+            continue;
+        }
+        c++;
+        if (*c == '%') {
+            continue;
+        }
+        while (*c == '0' || *c == '-' || *c == '+' || *c == ' ') {
+            c++;
+        }
+        while (*c >= '0' && *c <= '9') {
+            c++;
+        }
+        if (*c != 'd' && *c != 'i') {
+            return -1;
+        }
+        count++;
+    }
+    return count;
+}
+
+static
+void WriteFrame(SequenceWriter *writer, Image frame, int frameIndex) {
+    bool written;
+    char path[512];
+    if (writer->rawFile != NULL) {
+        int pixels = frame.width * frame.height;
+        written = fwrite(frame.data, 4, pixels, writer->rawFile)
+            == (size_t)pixels;
+        snprintf(path, sizeof(path), "%s", writer->output);
+    } else {
+        snprintf(path, sizeof(path), writer->output, frameIndex);
+        written = ExportImage(frame, path);
+    }
+    UnloadImage(frame);
+    if (!written) {
+        printf("WARNING: Could not write frame %d into '%s'.\n",
+               frameIndex, path);
+        AtomicStore(&writer->failed, 1);
+    }
+}
+
+static
+void SequenceWriterThread(void *data) {
+    SequenceWriter *writer = (SequenceWriter *)data;
+    while (AtomicLoad(&writer->running) || AtomicLoad(&writer->framePending)) {
+        if (AtomicLoad(&writer->framePending)) {
+            WriteFrame(writer, writer->frame, writer->frameIndex);
+            AtomicStore(&writer->framePending, 0);
+        } else {
+            SleepSeconds(WRITER_POLL_INTERVAL);
+        }
+    }
+}
+
+SequenceWriter *StartSequenceWriter(const char *output) {
+    bool perFrameFiles = strchr(output, '%') != NULL;
+    if (perFrameFiles && CountIntegerConversions(output) != 1) {
+        printf("WARNING: '%s' should have exactly one integer format "
+               "(e.g. %%05d) for the frame number.\n", output);
+        return NULL;
+    }
+
+    SequenceWriter *writer = (SequenceWriter *)calloc(1, sizeof(SequenceWriter));
+    if (writer == NULL) {
+        return NULL;
+    }
+    writer->output = output;
+    // Incremented before each frame, so that the first one is 0
+    writer->frameIndex = -1;
+    if (!perFrameFiles) {
+        writer->rawFile = fopen(output, "wb");
+        if (writer->rawFile == NULL) {
+            printf("WARNING: Could not open '%s' for writing frames.\n", output);
+            free(writer);
+            return NULL;
+        }
+    }
+
+    AtomicStore(&writer->running, 1);
+    writer->thread = StartThread(SequenceWriterThread, writer);
+    if (writer->thread == NULL) {
+        printf("WARNING: Frame writer thread could not be started, "
+               "writing frames on the main thread.\n");
+    }
+    return writer;
+}
+
+bool WriteSequenceFrame(SequenceWriter *writer, Image frame) {
+    int frameIndex = writer->frameIndex + 1;
+    if (writer->thread == NULL) {
+        if (AtomicLoad(&writer->failed)) {
+            UnloadImage(frame);
+            return false;
+        }
+        writer->frameIndex = frameIndex;
+        WriteFrame(writer, frame, frameIndex);
+        return !AtomicLoad(&writer->failed);
+    }
+
+    while (AtomicLoad(&writer->framePending)) {
+        SleepSeconds(WRITER_POLL_INTERVAL);
+    }
+    if (AtomicLoad(&writer->failed)) {
+        UnloadImage(frame);
+        return false;
+    }
+    writer->frame = frame;
+    writer->frameIndex = frameIndex;
+    AtomicStore(&writer->framePending, 1);
+    return true;
+}
+
+bool FinishSequenceWriter(SequenceWriter *writer) {
+    if (writer->thread != NULL) {
+        AtomicStore(&writer->running, 0);
+        JoinThread(writer->thread);
+    }
+    if (writer->rawFile != NULL && fclose(writer->rawFile) != 0) {
+        printf("WARNING: Could not finish writing frames into '%s'.\n",
+               writer->output);
+        AtomicStore(&writer->failed, 1);
+    }
+    bool succeeded = !AtomicLoad(&writer->failed);
+    free(writer);
+    return succeeded;
+}
@@ -0,0 +1,57 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <stdbool.h>
+
+#include "raylib.h"
+
+// Offline rendering of frame sequences (for trailers and such): the
+// camera moves along a spline through keyframes, and the frames are
+// written out on a separate thread while the next one is rendering.
+
+typedef struct {
+    float position[3];
+    // Degrees, like the game's camera, and not wrapped around
+    float rotation[3];
+} CameraKeyframe;
+
+// Catmull-Rom spline through the keyframes, t goes from 0 at the first
+// keyframe to 1 at the last one.
+CameraKeyframe GetCameraSplinePoint(const CameraKeyframe *keyframes,
+                                    int keyframeCount, float t);
+
+typedef struct SequenceWriter SequenceWriter;
+
+// If output contains a printf-style integer format (e.g.
+// "frames/%05d.png"), each frame is written into a PNG of its own. Any
+// other '%' than that one format and "%%" is an error. Otherwise, the
+// frames are appended to output as raw RGBA, which can be a named pipe
+// read by ffmpeg. Returns NULL if output is invalid or can't be opened.
+SequenceWriter *StartSequenceWriter(const char *output);
+// Takes ownership of the image. Waits if the previous frame is still
+// being written, so that only one frame is held in memory at a time.
+// Returns false once a frame has failed to be written, after which the
+// rest are dropped.
+bool WriteSequenceFrame(SequenceWriter *writer, Image frame);
+// Waits for the last frame to be written, and frees the writer. Returns
+// false if any of the frames couldn't be written.
+bool FinishSequenceWriter(SequenceWriter *writer);
+
+#endif
@@ -0,0 +1,153 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Based on the EASU pass of AMD FidelityFX Super Resolution 1:
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Edge-adaptive spatial upscaling, a simplified take on the EASU pass
+// of AMD's FidelityFX Super Resolution 1. The scene is ray marched
+// into a smaller render texture, and this shader reconstructs it to
+// the full virtual resolution with a Lanczos-like kernel that is
+// stretched along the edges it finds in the 4x4 texel neighbourhood.
+
+// (the version header is added in code, like in sdf.glsl)
+
+#if __VERSION__ == 330
+#define varying in
+#define texture2D texture
+out vec4 out_color;
+#endif
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec2 sourceSize;
+
+float luma(vec3 color) {
+    return color.g + 0.5 * (color.r + color.b);
+}
+
+vec3 fetch(vec2 texel) {
+    return texture2D(texture0, (texel + 0.5) / sourceSize).rgb;
+}
+
+// Returns the gradient at a texel (xy) and how much it looks like an
+// edge instead of a lone peak (z), based on its neighbours' luma.
+vec3 edge(float center, float left, float right, float up, float down) {
+    float dx = right - left;
+    float dy = down - up;
+    float lenX = abs(dx) / max(max(abs(right - center), abs(center - left)), 1.0 / 65536.0);
+    float lenY = abs(dy) / max(max(abs(down - center), abs(center - up)), 1.0 / 65536.0);
+    lenX = clamp(lenX, 0.0, 1.0);
+    lenY = clamp(lenY, 0.0, 1.0);
+    return vec3(dx, dy, lenX * lenX + lenY * lenY);
+}
+
+void main() {
+    vec2 position = fragTexCoord * sourceSize - 0.5;
+    vec2 base = floor(position);
+    vec2 offset = position - base;
+
+    // The 4x4 neighbourhood, where the output pixel sits inside the
+    // quad made of the texels at indices 5, 6, 9 and 10
+    vec3 colors[16];
+    float lumas[16];
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            vec3 color = fetch(base + vec2(float(x) - 1.0, float(y) - 1.0));
+            colors[y * 4 + x] = color;
+            lumas[y * 4 + x] = luma(color);
+        }
+    }
+
+    // Edge direction and strength, bilinearly weighted from the inner quad
+    vec3 e5 = edge(lumas[5], lumas[4], lumas[6], lumas[1], lumas[9]);
+    vec3 e6 = edge(lumas[6], lumas[5], lumas[7], lumas[2], lumas[10]);
+    vec3 e9 = edge(lumas[9], lumas[8], lumas[10], lumas[5], lumas[13]);
+    vec3 e10 = edge(lumas[10], lumas[9], lumas[11], lumas[6], lumas[14]);
+    vec3 edges = e5 * (1.0 - offset.x) * (1.0 - offset.y) +
+        e6 * offset.x * (1.0 - offset.y) +
+        e9 * (1.0 - offset.x) * offset.y +
+        e10 * offset.x * offset.y;
+    vec2 direction = edges.xy;
+    float directionLengthSq = dot(direction, direction);
+    if (directionLengthSq < 1.0 / 32768.0) {
+        direction = vec2(1.0, 0.0);
+    } else {
+        direction *= inversesqrt(directionLengthSq);
+    }
+    float edgeStrength = edges.z * 0.5;
+    edgeStrength *= edgeStrength;
+
+    // Stretch the kernel along the edge, and narrow its window on
+    // strong edges to keep them crisp
+    float stretch = 1.0 / max(abs(direction.x), abs(direction.y));
+    vec2 axisScale = vec2(1.0 + (stretch - 1.0) * edgeStrength,
+                          1.0 - 0.5 * edgeStrength);
+    float lobe = 0.5 + ((1.0 / 4.0 - 0.04) - 0.5) * edgeStrength;
+    float clip = 1.0 / lobe;
+
+    vec3 colorSum = vec3(0.0, 0.0, 0.0);
+    float weightSum = 0.0;
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            vec2 d = vec2(float(x) - 1.0, float(y) - 1.0) - offset;
+            vec2 v = vec2(d.x * direction.x + d.y * direction.y,
+                          d.x * -direction.y + d.y * direction.x) * axisScale;
+            // Polynomial approximation of a windowed Lanczos 2
+            float d2 = min(dot(v, v), clip);
+            float lanczos = 2.0 / 5.0 * d2 - 1.0;
+            float window = lobe * d2 - 1.0;
+            lanczos = 25.0 / 16.0 * lanczos * lanczos - (25.0 / 16.0 - 1.0);
+            float weight = lanczos * window * window;
+            colorSum += colors[y * 4 + x] * weight;
+            weightSum += weight;
+        }
+    }
+    vec3 color = colorSum / weightSum;
+
+    // Dering by clamping to the inner quad
+    vec3 minColor = min(min(colors[5], colors[6]), min(colors[9], colors[10]));
+    vec3 maxColor = max(max(colors[5], colors[6]), max(colors[9], colors[10]));
+    vec4 finalColor = vec4(clamp(color, minColor, maxColor), 1.0) * fragColor;
+#if __VERSION__ == 330
+    out_color = finalColor;
+#else
+    gl_FragColor = finalColor;
+#endif
+}
@@ -0,0 +1,93 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* Based on the RCAS pass of AMD FidelityFX Super Resolution 1:
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Contrast-adaptive sharpening, a simplified take on the RCAS pass of
+// AMD's FidelityFX Super Resolution 1. This runs during the final
+// blit of the upscaled frame to the window, and sharpens per source
+// texel (not per window pixel) so the pixelated look is preserved.
+
+// (the version header is added in code, like in sdf.glsl)
+
+// Sharpness in stops, 0.0 is the strongest
+#define RCAS_SHARPNESS 0.25
+#define RCAS_LIMIT (0.25 - 1.0 / 16.0)
+
+#if __VERSION__ == 330
+#define varying in
+#define texture2D texture
+out vec4 out_color;
+#endif
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec2 sourceSize;
+
+vec3 fetch(vec2 texel) {
+    return texture2D(texture0, (texel + 0.5) / sourceSize).rgb;
+}
+
+void main() {
+    vec2 texel = floor(fragTexCoord * sourceSize);
+    vec3 up = fetch(texel + vec2(0.0, -1.0));
+    vec3 left = fetch(texel + vec2(-1.0, 0.0));
+    vec3 center = fetch(texel);
+    vec3 right = fetch(texel + vec2(1.0, 0.0));
+    vec3 down = fetch(texel + vec2(0.0, 1.0));
+
+    // Find the strongest negative lobe that doesn't clip the result
+    // outside the range of the neighbourhood
+    vec3 minRing = min(min(up, left), min(right, down));
+    vec3 maxRing = max(max(up, left), max(right, down));
+    vec3 hitMin = min(minRing, center) / max(4.0 * maxRing, 1.0 / 256.0);
+    vec3 hitMax = (1.0 - max(maxRing, center)) / (4.0 * minRing - 4.0 - 1.0 / 256.0);
+    vec3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-RCAS_LIMIT, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0));
+    lobe *= exp2(-RCAS_SHARPNESS);
+
+    vec3 color = (lobe * (up + left + right + down) + center) / (4.0 * lobe + 1.0);
+    vec4 finalColor = vec4(color, 1.0) * fragColor;
+#if __VERSION__ == 330
+    out_color = finalColor;
+#else
+    gl_FragColor = finalColor;
+#endif
+}
@@ -24,6 +24,16 @@
 #define RAY_STEPS_MAX 128
 #define SDF_SURFACE_THRESHOLD 0.01
 #define NORMAL_EPSILON 0.001
+#define SHADOW_STEPS_MAX 15
+#define AO_STEPS_MAX 4
+
+// Foveated rendering: at wide fields of view, the ray marching budget
+// is scaled down towards the edges of the screen, where the fog and
+// the noise hide most of the detail anyway
+#define FOVEATION_FOV_MIN 80.0
+#define FOVEATION_FOV_MAX 120.0
+#define FOVEATION_RADIUS 0.35
+#define FOVEATION_MIN_BUDGET 0.4
 
 // 3D environment defining variables
 // TODO: Make a better palette
@@ -54,6 +64,19 @@ struct SDFSample {
     vec3 color;
 };
 
+#if __VERSION__ == 330
+// Uploaded at once from the SDFParameters struct in sdf_shader.h, so
+// the members need to stay in the same order as there
+layout(std140) uniform SDFParameters {
+    vec2 resolution;
+    vec3 cameraPosition;
+    float cameraFieldOfView;
+    vec3 cameraRotation;
+    int stage;
+    float maxDistance;
+    bool foveated;
+};
+#else
 uniform vec2 resolution;
 uniform vec3 cameraPosition;
 uniform vec3 cameraRotation;
@@ -61,6 +84,12 @@ uniform float cameraFieldOfView;
 
 uniform int stage = 0;
 uniform float maxDistance = 100.0;
+uniform bool foveated = false;
+#endif
+
+// The fraction of the step counts above that the current pixel can
+// use, set in main() based on the foveation
+float rayBudget = 1.0;
 
 // The Ruoholahti-Lauttasaari line on page 41 of this pdf:
 // https://www.hel.fi/hel2/ksv/Aineistot/maanalainen/Maanalaisen_yleiskaavan_selostus.pdf
@@ -400,8 +429,12 @@ vec3 get_normal(vec3 samplePos) {
 float get_shadow(vec3 samplePos, vec3 lightPos) {
     vec3 direction = normalize(lightPos - samplePos);
     vec3 position = samplePos + direction * 0.2;
+    int maxSteps = int(float(SHADOW_STEPS_MAX) * rayBudget);
     int steps = 1;
-    for (; steps < 15; steps++) {
+    for (; steps < SHADOW_STEPS_MAX; steps++) {
+        if (steps >= maxSteps) {
+            break;
+        }
         SDFSample s = sdf(position, true);
         float maxDistance = length(lightPos - position);
         if (s.distance > maxDistance) {
@@ -409,7 +442,7 @@ float get_shadow(vec3 samplePos, vec3 lightPos) {
         }
 
         if (s.distance < SDF_SURFACE_THRESHOLD) {
-            return 1.0 - pow(float(steps) / 15.0, 1.5);
+            return 1.0 - pow(float(steps) / float(maxSteps), 1.5);
         } else {
             position += direction * s.distance;
         }
@@ -463,11 +496,15 @@ float get_ambient_occlusion(vec3 samplePos, vec3 normal) {
 
     float step = 0.01;
     vec3 position = samplePos + normal * step;
+    int maxSteps = int(max(1.0, float(AO_STEPS_MAX) * rayBudget + 0.5));
     int steps = 0;
-    for (; steps < 4; steps++) {
+    for (; steps < AO_STEPS_MAX; steps++) {
+        if (steps >= maxSteps) {
+            break;
+        }
         SDFSample s = sdf(position, false);
         if (s.distance <= (float(steps) + 1.0) * step) {
-            return 1.0 - float(steps) / 4.0;
+            return 1.0 - float(steps) / float(maxSteps);
         }
         position += min(s.distance, step);
     }
@@ -487,8 +524,12 @@ vec4 get_color(vec2 screenPosition, vec3 position, vec3 rotation) {
     bool hit = false;
     vec3 normal = vec3(0.0, 0.0, 0.0);
     vec3 color = vec3(1.0, 1.0, 1.0);
+    int maxSteps = int(float(RAY_STEPS_MAX) * rayBudget);
     int steps = 1;
     for (; steps < RAY_STEPS_MAX; steps++) {
+        if (steps >= maxSteps) {
+            break;
+        }
         SDFSample s = sdf(position, false);
         float distance = s.distance;
         if (distance < SDF_SURFACE_THRESHOLD) {
@@ -519,6 +560,12 @@ void main() {
     // NOTE: The y coordinate is flipped because we're rendering to a render texture
     vec2 pixelCoords = vec2((gl_FragCoord.x - resolution.x / 2.0) / resolution.y,
                             (gl_FragCoord.y - resolution.y / 2.0) / resolution.y * -1.0);
+    if (foveated) {
+        float foveation = smoothstep(FOVEATION_FOV_MIN, FOVEATION_FOV_MAX,
+                                     cameraFieldOfView);
+        float eccentricity = smoothstep(FOVEATION_RADIUS, 1.0, length(pixelCoords));
+        rayBudget = 1.0 - foveation * eccentricity * (1.0 - FOVEATION_MIN_BUDGET);
+    }
     vec4 finalColor = get_color(pixelCoords, cameraPosition, cameraRotation);
 #if __VERSION__ == 330
     out_color = finalColor;
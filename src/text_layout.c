@@ -0,0 +1,130 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "text_layout.h"
+#include "rlgl.h"
+
+// Follows the layout rules of DrawTextEx, so the text looks the same
+// either way
+TextLayout LayoutText(Font font, const char *text, float fontSize,
+                      float spacing) {
+    TextLayout layout = { 0 };
+    int length = strlen(text);
+    layout.textureId = font.texture.id;
+    layout.size = MeasureTextEx(font, text, fontSize, spacing);
+    // Every glyph takes at least one byte, so this is always enough
+    layout.glyphs = (LayoutGlyph *)malloc((length + 1) * sizeof(LayoutGlyph));
+
+    float scale = fontSize / font.baseSize;
+    float textureWidth = (float)font.texture.width;
+    float textureHeight = (float)font.texture.height;
+    float offsetX = 0.0f;
+    int offsetY = 0;
+    for (int i = 0; i < length; i++) {
+        int next = 1;
+        int codepoint = GetNextCodepoint(&text[i], &next);
+        // Invalid bytes are drawn one by one as '?', like in DrawTextEx
+        if (codepoint == 0x3f) {
+            next = 1;
+        }
+        i += next - 1;
+
+        if (codepoint == '\n') {
+            offsetY += (int)((font.baseSize + font.baseSize / 2) * scale);
+            offsetX = 0.0f;
+            continue;
+        }
+
+        CharInfo *info = &font.chars[GetGlyphIndex(font, codepoint)];
+        if (codepoint != ' ') {
+            LayoutGlyph *glyph = &layout.glyphs[layout.glyphCount++];
+            glyph->dest = (Rectangle){
+                offsetX + info->offsetX * scale,
+                offsetY + info->offsetY * scale,
+                info->rec.width * scale, info->rec.height * scale
+            };
+            glyph->texcoords[0] = info->rec.x / textureWidth;
+            glyph->texcoords[1] = info->rec.y / textureHeight;
+            glyph->texcoords[2] = (info->rec.x + info->rec.width) / textureWidth;
+            glyph->texcoords[3] = (info->rec.y + info->rec.height) / textureHeight;
+        }
+
+        if (info->advanceX == 0) {
+            offsetX += info->rec.width * scale + spacing;
+        } else {
+            offsetX += info->advanceX * scale + spacing;
+        }
+    }
+    return layout;
+}
+
+void DrawTextLayout(TextLayout layout, Vector2 position, Color tint) {
+    for (int i = 0; i < layout.glyphCount; i++) {
+        LayoutGlyph *glyph = &layout.glyphs[i];
+        rlDrawGlyph(layout.textureId,
+                    position.x + glyph->dest.x, position.y + glyph->dest.y,
+                    glyph->dest.width, glyph->dest.height,
+                    glyph->texcoords[0], glyph->texcoords[1],
+                    glyph->texcoords[2], glyph->texcoords[3], tint);
+    }
+}
+
+void UnloadTextLayout(TextLayout layout) {
+    free(layout.glyphs);
+}
+
+TextLayout GetCachedTextLayout(TextLayoutCache *cache, Font font,
+                               const char *text, float fontSize,
+                               float spacing) {
+    cache->useCounter++;
+    TextLayoutCacheEntry *replaced = &cache->entries[0];
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++) {
+        TextLayoutCacheEntry *entry = &cache->entries[i];
+        if (entry->text != NULL && entry->textureId == font.texture.id &&
+            entry->fontSize == fontSize && entry->spacing == spacing &&
+            strcmp(entry->text, text) == 0) {
+            entry->lastUsed = cache->useCounter;
+            return entry->layout;
+        }
+        if (entry->lastUsed < replaced->lastUsed) {
+            replaced = entry;
+        }
+    }
+
+    free(replaced->text);
+    UnloadTextLayout(replaced->layout);
+    size_t textSize = strlen(text) + 1;
+    replaced->text = (char *)malloc(textSize);
+    memcpy(replaced->text, text, textSize);
+    replaced->textureId = font.texture.id;
+    replaced->fontSize = fontSize;
+    replaced->spacing = spacing;
+    replaced->layout = LayoutText(font, text, fontSize, spacing);
+    replaced->lastUsed = cache->useCounter;
+    return replaced->layout;
+}
+
+void ClearTextLayoutCache(TextLayoutCache *cache) {
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++) {
+        free(cache->entries[i].text);
+        UnloadTextLayout(cache->entries[i].layout);
+    }
+    *cache = (TextLayoutCache){ 0 };
+}
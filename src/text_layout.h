@@ -0,0 +1,70 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include "raylib.h"
+
+// Text shaped once for a font and size. The glyph quads are positioned
+// relative to the top-left corner of the text, so drawing it skips the
+// codepoint decoding, glyph lookups and measuring DrawTextEx does.
+
+typedef struct {
+    Rectangle dest;
+    // The glyph's rectangle in the font atlas, as texture coordinates
+    float texcoords[4];
+} LayoutGlyph;
+
+typedef struct {
+    unsigned int textureId;
+    // The same size MeasureTextEx returns for the text
+    Vector2 size;
+    int glyphCount;
+    LayoutGlyph *glyphs;
+} TextLayout;
+
+TextLayout LayoutText(Font font, const char *text, float fontSize,
+                      float spacing);
+void DrawTextLayout(TextLayout layout, Vector2 position, Color tint);
+void UnloadTextLayout(TextLayout layout);
+
+// Keeps the layouts of strings that are drawn every frame, but don't
+// have a fixed place to keep their layout in, like the menu labels.
+// The least recently used layout is replaced when the cache is full.
+#define TEXT_LAYOUT_CACHE_SIZE 32
+
+typedef struct {
+    char *text;
+    unsigned int textureId;
+    float fontSize;
+    float spacing;
+    TextLayout layout;
+    unsigned int lastUsed;
+} TextLayoutCacheEntry;
+
+typedef struct {
+    TextLayoutCacheEntry entries[TEXT_LAYOUT_CACHE_SIZE];
+    unsigned int useCounter;
+} TextLayoutCache;
+
+TextLayout GetCachedTextLayout(TextLayoutCache *cache, Font font,
+                               const char *text, float fontSize,
+                               float spacing);
+void ClearTextLayoutCache(TextLayoutCache *cache);
+
+#endif
@@ -0,0 +1,124 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined(_WIN32)
+// For nanosleep
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// This file doesn't include raylib.h, because windows.h clashes with it
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#include "thread.h"
+
+struct Thread {
+    void (*function)(void *);
+    void *data;
+#if defined(_WIN32)
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+};
+
+#if defined(_WIN32)
+static DWORD WINAPI RunThread(LPVOID thread) {
+    ((Thread *)thread)->function(((Thread *)thread)->data);
+    return 0;
+}
+#else
+static void *RunThread(void *thread) {
+    ((Thread *)thread)->function(((Thread *)thread)->data);
+    return NULL;
+}
+#endif
+
+Thread *StartThread(void (*function)(void *), void *data) {
+    Thread *thread = (Thread *)malloc(sizeof(Thread));
+    if (thread == NULL) {
+        return NULL;
+    }
+    thread->function = function;
+    thread->data = data;
+#if defined(_WIN32)
+    thread->handle = CreateThread(NULL, 0, RunThread, thread, 0, NULL);
+    bool started = thread->handle != NULL;
+#else
+    bool started = pthread_create(&thread->handle, NULL, RunThread, thread) == 0;
+#endif
+    if (!started) {
+        free(thread);
+        return NULL;
+    }
+    return thread;
+}
+
+void JoinThread(Thread *thread) {
+#if defined(_WIN32)
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+void SleepSeconds(double seconds) {
+    if (seconds <= 0.0) {
+        return;
+    }
+#if defined(_WIN32)
+    Sleep((DWORD)(seconds * 1000.0));
+#else
+    struct timespec duration;
+    duration.tv_sec = (time_t)seconds;
+    duration.tv_nsec = (long)((seconds - (double)duration.tv_sec) * 1e9);
+    nanosleep(&duration, NULL);
+#endif
+}
+
+long AtomicLoad(volatile long *source) {
+#if defined(_WIN32)
+    return InterlockedCompareExchange(source, 0, 0);
+#else
+    return __atomic_load_n(source, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void AtomicStore(volatile long *target, long value) {
+#if defined(_WIN32)
+    InterlockedExchange(target, value);
+#else
+    __atomic_store_n(target, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+long AtomicExchange(volatile long *target, long value) {
+#if defined(_WIN32)
+    return InterlockedExchange(target, value);
+#else
+    return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+#endif
+}
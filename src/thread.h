@@ -0,0 +1,37 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREAD_H
+#define THREAD_H
+
+// A small wrapper over Win32 and POSIX threads, for the few places
+// where the game needs them.
+
+typedef struct Thread Thread;
+
+// Returns NULL if the thread couldn't be started.
+Thread *StartThread(void (*function)(void *), void *data);
+// Waits for the thread to return, and frees it.
+void JoinThread(Thread *thread);
+void SleepSeconds(double seconds);
+
+// Sequentially consistent operations on values shared between threads.
+long AtomicLoad(volatile long *source);
+void AtomicStore(volatile long *target, long value);
+long AtomicExchange(volatile long *target, long value);
+
+#endif
@@ -0,0 +1,64 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+
+#include "triple_buffer.h"
+#include "thread.h"
+
+// Set in sharedIndex when the shared slot has been published, but not
+// read yet. The rest of the bits are the index of the slot.
+#define SLOT_FRESH 4
+#define SLOT_INDEX_MASK 3
+
+TripleBuffer LoadTripleBuffer(size_t slotSize) {
+    TripleBuffer buffer = { 0 };
+    buffer.slots = (unsigned char *)calloc(3, slotSize);
+    buffer.slotSize = slotSize;
+    buffer.writeIndex = 0;
+    buffer.sharedIndex = 1;
+    buffer.readIndex = 2;
+    return buffer;
+}
+
+void UnloadTripleBuffer(TripleBuffer *buffer) {
+    free(buffer->slots);
+    buffer->slots = NULL;
+}
+
+void *GetTripleBufferWriteSlot(TripleBuffer *buffer) {
+    return buffer->slots + buffer->writeIndex * buffer->slotSize;
+}
+
+void PublishTripleBuffer(TripleBuffer *buffer) {
+    // The written slot becomes the shared one, and the writer gets the
+    // previously shared slot, which the reader is done with
+    long previous = AtomicExchange(&buffer->sharedIndex,
+                                   buffer->writeIndex | SLOT_FRESH);
+    buffer->writeIndex = (int)(previous & SLOT_INDEX_MASK);
+}
+
+const void *ReadTripleBuffer(TripleBuffer *buffer) {
+    // Only swap when there's something new, otherwise the reader could
+    // get back an older slot it has already read
+    if (AtomicLoad(&buffer->sharedIndex) & SLOT_FRESH) {
+        long previous = AtomicExchange(&buffer->sharedIndex,
+                                       buffer->readIndex);
+        buffer->readIndex = (int)(previous & SLOT_INDEX_MASK);
+    }
+    return buffer->slots + buffer->readIndex * buffer->slotSize;
+}
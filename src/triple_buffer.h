@@ -0,0 +1,43 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stddef.h>
+
+// Hands off the latest version of some data from one thread to another
+// without locks. The writer always has a slot of its own to write to,
+// and the reader always has the latest published slot to read from.
+typedef struct {
+    unsigned char *slots;
+    size_t slotSize;
+    int writeIndex;
+    int readIndex;
+    // The slot between the two, see triple_buffer.c
+    volatile long sharedIndex;
+} TripleBuffer;
+
+TripleBuffer LoadTripleBuffer(size_t slotSize);
+void UnloadTripleBuffer(TripleBuffer *buffer);
+// Writer side: the returned slot is published with PublishTripleBuffer.
+void *GetTripleBufferWriteSlot(TripleBuffer *buffer);
+void PublishTripleBuffer(TripleBuffer *buffer);
+// Reader side: the returned slot stays valid until the next call.
+const void *ReadTripleBuffer(TripleBuffer *buffer);
+
+#endif
@@ -0,0 +1,39 @@
+/* This is a game where the player walks through a metro tunnel.
+ * Copyright (C) 2019  Jens Pitkanen <jens@neon.moe>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compiles the narration script in src/script.h into the asset the game
+// reads. The build scripts build and run this with the host compiler:
+//     cc -std=c99 -o compile_script tools/compile_script.c src/narration.c
+//     ./compile_script metro_assets/script.bin
+
+#include <stdio.h>
+
+#include "../src/script.h"
+#include "../src/narration.h"
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        printf("Usage: %s <output path>\n", argv[0]);
+        return 1;
+    }
+    bool saved = SaveNarrationScript(argv[1], &narratorComments[0][0],
+                                     COMMENTS_COUNT, COMMENT_LINES,
+                                     COMMENT_START, COMMENT_LENGTH,
+                                     METERS_PER_CHARACTER,
+                                     METERS_PER_CHARACTER * 2.0f);
+    return saved ? 0 : 1;
+}
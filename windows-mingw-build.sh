@@ -82,6 +82,15 @@ else
         CC=gcc
     fi
 fi
+# The tools run during the build use the host's compiler, which is also
+# the compiler when not cross-compiling
+if [ -z "$HOST_CC" ]; then
+    if command -v cc > /dev/null 2>&1; then
+        HOST_CC=cc
+    else
+        HOST_CC=$CC
+    fi
+fi
 
 # Directories
 ROOT_DIR=$PWD
@@ -153,6 +162,10 @@ rm *.o
 mkdir -p metro_assets
 cd metro_assets
 cp $ROOT_DIR/resources/icon.png .
+# The narration script is compiled from src/script.h by a tool that runs
+# on the build machine, so it's built with the host's compiler
+$HOST_CC -std=c99 -o $ROOT_DIR/$TEMP_DIR/compile_script $ROOT_DIR/tools/compile_script.c $ROOT_DIR/src/narration.c
+$ROOT_DIR/$TEMP_DIR/compile_script script.bin
 cp -r $ROOT_DIR/src/shaders .
 mkdir -p fonts
 cp $ROOT_DIR/vendor/vt323/vt323.ttf fonts/
@@ -211,9 +211,15 @@ REM Copy resources
 IF NOT EXIST metro_assets mkdir metro_assets
 cd metro_assets
 IF NOT EXIST "icon.png" cp !ROOT_DIR!\resources\icon.png icon.png
+REM The narration script is compiled from src\script.h by a small tool
+IF NOT EXIST !ROOT_DIR!\temp\tools mkdir !ROOT_DIR!\temp\tools
+cl.exe /nologo /Fe"!ROOT_DIR!\temp\tools\compile_script.exe" /Fo"!ROOT_DIR!\temp\tools\\" "!ROOT_DIR!\tools\compile_script.c" "!ROOT_DIR!\src\narration.c" > NUL || exit /B
+"!ROOT_DIR!\temp\tools\compile_script.exe" script.bin || exit /B
 IF NOT EXIST shaders mkdir shaders
 IF EXIST "shaders\sdf_shader.glsl" del shaders\sdf_shader.glsl
 cp !ROOT_DIR!\src\shaders\sdf.glsl shaders\sdf.glsl
+cp !ROOT_DIR!\src\shaders\easu.glsl shaders\easu.glsl
+cp !ROOT_DIR!\src\shaders\rcas.glsl shaders\rcas.glsl
 IF NOT EXIST fonts mkdir fonts
 IF NOT EXIST "fonts\open_sans.ttf" cp !ROOT_DIR!\vendor\open-sans\open_sans.ttf fonts\open_sans.ttf
 IF NOT EXIST "fonts\vt323.ttf" cp !ROOT_DIR!\vendor\vt323\vt323.ttf fonts\vt323.ttf